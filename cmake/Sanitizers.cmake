@@ -2,7 +2,7 @@ function(enable_sanitizers project_name)
     
     set(SANITIZERS "")
 
-    if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU" OR CMAKE_CXX_COMPILER_ID STREQUAL "^(Apple)?Clang$")
+    if (CMAKE_CXX_COMPILER_ID STREQUAL "GNU" OR CMAKE_CXX_COMPILER_ID MATCHES "^(Apple)?Clang$")
         option(ENABLE_CONVERAGE "Enable coverage reporting for gcc/clang" OFF)
         if (ENABLE_CONVERAGE)
             target_compile_options(${project_name} INTERFACE --coverage -O0 -g)
@@ -34,7 +34,7 @@ function(enable_sanitizers project_name)
     
     list(JOIN SANITIZERS "," SANITIZERS_STRING)
 
-    if (NOT "S{SANITIZERS_STRING}" STREQUAL "")
+    if (NOT "${SANITIZERS_STRING}" STREQUAL "")
         target_compile_options(${project_name} INTERFACE -fsanitize=${SANITIZERS_STRING})
         target_link_libraries(${project_name} INTERFACE -fsanitize=${SANITIZERS_STRING})
     endif()
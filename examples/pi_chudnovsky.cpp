@@ -0,0 +1,135 @@
+// Digits of pi from the Chudnovsky series, summed with `binary_split`.
+//
+//   pi = 426880 sqrt(10005) / sum over k of a(k) p(0) ... p(k) / (q(0) ... q(k))
+//   p(k) = -(6k - 5)(2k - 1)(6k - 1), q(k) = k^3 640320^3 / 24, a(k) = 13591409 + 545140134 k
+//
+// usage: pi_chudnovsky [digits = 100000] [threads = 1] [--bench]
+// With --bench the digit count is doubled from 10^4 up to `digits` and only the
+// timings are printed.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <print>
+#include <string>
+#include "big_num/internal/integer.hpp"
+#include "big_num/internal/integer_parse.hpp"
+#include "big_num/internal/mul/mul.hpp"
+#include "big_num/internal/ops.hpp"
+#include "big_num/internal/div/prepared.hpp"
+#include "big_num/internal/root/sqrt.hpp"
+#include "big_num/internal/series/binary_split.hpp"
+
+using namespace big_num::internal;
+
+namespace {
+    using val_t = Integer::value_type;
+
+    // 640320^3 / 24 = 2^15 3^2 5^3 23^3 29^3
+    constexpr val_t c3_24_lo = 32'768u * 9u * 125u;   // 2^15 3^2 5^3
+    constexpr val_t c3_24_hi = 12'167u * 24'389u;     // 23^3 29^3
+    constexpr double digits_per_term = 14.181647462725477;
+
+    struct ChudnovskyTerm {
+        auto operator()(std::size_t k, Integer& p, Integer& q, Integer& a) const -> void {
+            if (k == 0) {
+                assign_word_product(p, { 1 });
+                assign_word_product(q, { 1 });
+                assign_word_product(a, { 13'591'409u });
+                return;
+            }
+            auto const kv = static_cast<val_t>(k);
+            assign_word_product(p, { 6 * kv - 5, 2 * kv - 1, 6 * kv - 1 }, true);
+            assign_word_product(q, { kv, kv, kv, c3_24_lo, c3_24_hi });
+            auto t = Integer{};
+            auto c = Integer{};
+            assign_word_product(t, { 545'140'134u, kv });
+            assign_word_product(c, { 13'591'409u });
+            add(a, t, c);
+        }
+    };
+
+    struct Timings {
+        double split{};
+        double sqrt{};
+        double div{};
+        double print{};
+    };
+
+    auto seconds_since(std::chrono::steady_clock::time_point t) -> double {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t).count();
+    }
+
+    // floor(pi * 10^digits) as a decimal string
+    auto compute_pi(std::size_t digits, std::size_t threads, Timings& time) -> std::string {
+        auto const terms = static_cast<std::size_t>(static_cast<double>(digits) / digits_per_term) + 2;
+
+        auto start = std::chrono::steady_clock::now();
+        auto q = Integer{};
+        auto t = Integer{};
+        binary_split(q, t, ChudnovskyTerm{}, 0, terms, threads);
+        time.split = seconds_since(start);
+
+        // sqrt(10005 * 10^(2 digits))
+        start = std::chrono::steady_clock::now();
+        auto scale = Integer{};
+        assign_word_product(scale, { 10 });
+        pow(scale, 2 * digits);
+        auto c = Integer{};
+        assign_word_product(c, { 10'005 });
+        auto rad = Integer{};
+        mul(rad, scale, c);
+        auto s = Integer{};
+        isqrt(s, rad);
+        time.sqrt = seconds_since(start);
+
+        // 426880 * s * q / t
+        start = std::chrono::steady_clock::now();
+        auto sq = Integer{};
+        mul(sq, s, q);
+        assign_word_product(c, { 426'880u });
+        auto num = Integer{};
+        mul(num, sq, c);
+        auto pi = Integer{};
+        auto rem = Integer{};
+        PreparedDivisor(t.to_span()).divmod(pi, rem, num);
+        time.div = seconds_since(start);
+
+        start = std::chrono::steady_clock::now();
+        auto res = to_string(pi.to_span());
+        time.print = seconds_since(start);
+        return res;
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    auto digits = std::size_t{100'000};
+    auto threads = std::size_t{1};
+    auto bench = false;
+    auto pos = 0;
+    for (auto i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bench") == 0) {
+            bench = true;
+        } else if (pos++ == 0) {
+            digits = std::stoul(argv[i]);
+        } else {
+            threads = std::stoul(argv[i]);
+        }
+    }
+
+    if (bench) {
+        std::println("{:>10} {:>10} {:>10} {:>10} {:>10}", "digits", "split", "sqrt", "div", "print");
+        for (auto d = std::size_t{10'000}; d <= digits; d *= 2) {
+            auto time = Timings{};
+            compute_pi(d, threads, time);
+            std::println("{:>10} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f}", d, time.split, time.sqrt, time.div, time.print);
+        }
+        return 0;
+    }
+
+    auto time = Timings{};
+    auto const pi = compute_pi(digits, threads, time);
+    std::println("{}.{}", pi.substr(0, 1), pi.substr(1));
+    std::println(stderr, "split: {:.3f}s, sqrt: {:.3f}s, div: {:.3f}s, print: {:.3f}s", time.split, time.sqrt, time.div, time.print);
+    return 0;
+}
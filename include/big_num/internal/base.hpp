@@ -88,7 +88,10 @@ namespace big_num::internal {
         #endif
 
         #ifndef BIG_NUM_PARSE_NAIVE_THRESHOLD
-        static constexpr std::size_t parse_naive_threshold = 2'000zu;
+        // Digits; with nine digits per basecase pass the basecase beat a single
+        // split up to 24'000 digits, and on 200'000 digits 16'000 was the fastest
+        // of the leaf sizes tried.
+        static constexpr std::size_t parse_naive_threshold = 16'000zu;
         #else
         static constexpr std::size_t parse_naive_threshold = nearest_even_number(BIG_NUM_PARSE_NAIVE_THRESHOLD);
         #endif
@@ -98,6 +101,54 @@ namespace big_num::internal {
         #else
         static constexpr std::size_t parse_dc_threshold = nearest_even_number(BIG_NUM_PARSE_DIVIDE_CONQUER_THRESHOLD);
         #endif
+
+        #ifndef BIG_NUM_TO_STRING_NAIVE_THRESHOLD
+        static constexpr std::size_t to_string_naive_threshold = 32zu; // blocks
+        #else
+        static constexpr std::size_t to_string_naive_threshold = BIG_NUM_TO_STRING_NAIVE_THRESHOLD;
+        #endif
+
+        #ifndef BIG_NUM_RADIX_CACHE_BLOCKS
+        // Bound on the radix powers kept per radix for parsing and printing (4 MiB).
+        static constexpr std::size_t radix_cache_blocks = 1zu << 20; // blocks
+        #else
+        static constexpr std::size_t radix_cache_blocks = BIG_NUM_RADIX_CACHE_BLOCKS;
+        #endif
+
+        #ifndef BIG_NUM_DIV_BARRETT_THRESHOLD
+        static constexpr std::size_t div_barrett_threshold = 100zu;
+        #else
+        static constexpr std::size_t div_barrett_threshold = BIG_NUM_DIV_BARRETT_THRESHOLD;
+        #endif
+
+        #ifndef BIG_NUM_HGCD_THRESHOLD
+        // Lehmer beat the half-GCD at every size measured, up to 2^16 blocks, with
+        // Toom-3 as the top `mul` tier; re-measure once a transform-based
+        // multiplication is dispatched from `mul`.
+        static constexpr std::size_t hgcd_threshold = 1zu << 18; // blocks
+        #else
+        static constexpr std::size_t hgcd_threshold = BIG_NUM_HGCD_THRESHOLD;
+        #endif
+
+        #ifndef BIG_NUM_POWM_SEC_WINDOW_BITS
+        static constexpr std::size_t powm_sec_window_bits = 4zu;
+        #else
+        static constexpr std::size_t powm_sec_window_bits = BIG_NUM_POWM_SEC_WINDOW_BITS;
+        #endif
+
+        #ifndef BIG_NUM_PRIME_TRIAL_BOUND
+        static constexpr std::size_t prime_trial_bound = 2'048zu; // small primes below this
+        #else
+        static constexpr std::size_t prime_trial_bound = BIG_NUM_PRIME_TRIAL_BOUND;
+        #endif
+
+        #ifndef BIG_NUM_CRT_GARNER_THRESHOLD
+        // Garner was faster up to 1'536 moduli and the product-tree sum from 4'096
+        // on; in between the two were within noise of each other.
+        static constexpr std::size_t crt_garner_threshold = 2'048zu; // moduli
+        #else
+        static constexpr std::size_t crt_garner_threshold = BIG_NUM_CRT_GARNER_THRESHOLD;
+        #endif
     };
 
 
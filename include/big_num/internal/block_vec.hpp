@@ -0,0 +1,234 @@
+#ifndef AMT_BIG_NUM_INTERNAL_BLOCK_VEC_HPP
+#define AMT_BIG_NUM_INTERNAL_BLOCK_VEC_HPP
+
+#include "integer.hpp"
+#include "base.hpp"
+#include "cmp.hpp"
+#include "add_sub.hpp"
+#include "logical_bitwise.hpp"
+#include "div/schoolbook.hpp"
+#include "mul/mul.hpp"
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        /**
+         * Growable magnitude for algorithms whose intermediate sizes are not known up
+         * front (gcd, roots, ...). Always kept trimmed; the empty vector is zero.
+         * Memory comes from the resource the vector was built with.
+        */
+        using block_vec_t = std::pmr::vector<Integer::value_type>;
+
+        inline static constexpr auto vec_trim(block_vec_t& a) noexcept -> void {
+            while (!a.empty() && a.back() == 0) a.pop_back();
+        }
+
+        // Bit length of a trimmed span.
+        inline static constexpr auto vec_bits(
+            std::span<Integer::value_type const> a
+        ) noexcept -> std::size_t {
+            if (a.empty()) return 0;
+            return (a.size() - 1) * MachineConfig::bits + static_cast<std::size_t>(std::bit_width(a.back()));
+        }
+
+        inline static constexpr auto vec_compare(
+            std::span<Integer::value_type const> a,
+            std::span<Integer::value_type const> b
+        ) noexcept -> std::strong_ordering {
+            return abs_compare(a, b);
+        }
+
+        inline static constexpr auto vec_set(
+            block_vec_t& out,
+            MachineConfig::acc_t v
+        ) -> void {
+            out.clear();
+            for (; v != 0; v >>= MachineConfig::bits) {
+                out.push_back(static_cast<Integer::value_type>(v & MachineConfig::mask));
+            }
+        }
+
+        // Value of a span that fits the accumulator.
+        inline static constexpr auto vec_get(
+            std::span<Integer::value_type const> a
+        ) noexcept -> MachineConfig::acc_t {
+            auto r = MachineConfig::acc_t{};
+            for (auto i = a.size(); i > 0; --i) r = (r << MachineConfig::bits) | a[i - 1];
+            return r;
+        }
+
+        // out = in >> p
+        inline static constexpr auto vec_shift_right(
+            block_vec_t& out,
+            std::span<Integer::value_type const> in,
+            std::size_t p
+        ) -> void {
+            auto const blocks = p / MachineConfig::bits;
+            out.clear();
+            if (blocks >= in.size()) return;
+            out.resize(in.size() - blocks, 0);
+            shift_right(std::span(out), in.subspan(blocks), p % MachineConfig::bits);
+            vec_trim(out);
+        }
+
+        // out = in << p
+        inline static constexpr auto vec_shift_left(
+            block_vec_t& out,
+            std::span<Integer::value_type const> in,
+            std::size_t p
+        ) -> void {
+            auto const blocks = p / MachineConfig::bits;
+            out.clear();
+            if (in.empty()) return;
+            out.resize(in.size() + blocks + 1, 0);
+            auto const rest = std::span(out).subspan(blocks);
+            rest.back() = shift_left(rest.first(in.size()), in, p % MachineConfig::bits);
+            vec_trim(out);
+        }
+
+        // out = in mod 2^p
+        inline static constexpr auto vec_low_bits(
+            block_vec_t& out,
+            std::span<Integer::value_type const> in,
+            std::size_t p
+        ) -> void {
+            auto const blocks = std::min(in.size(), (p + MachineConfig::bits - 1) / MachineConfig::bits);
+            out.assign(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(blocks));
+            auto const rem = p % MachineConfig::bits;
+            if (rem != 0 && blocks * MachineConfig::bits > p) {
+                out.back() &= static_cast<Integer::value_type>((Integer::value_type{1} << rem) - 1);
+            }
+            vec_trim(out);
+        }
+
+        // out = a * b; out must not alias a or b
+        inline static constexpr auto vec_mul(
+            block_vec_t& out,
+            std::span<Integer::value_type const> a,
+            std::span<Integer::value_type const> b,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            out.clear();
+            if (a.empty() || b.empty()) return;
+            out.resize(a.size() + b.size(), 0);
+            mul_unbalanced(
+                num_t(out.data(), out.size()),
+                const_num_t(a.data(), a.size()),
+                const_num_t(b.data(), b.size()),
+                resource
+            );
+            vec_trim(out);
+        }
+
+        // out = a^2 through the dedicated square path; out must not alias a
+        inline static constexpr auto vec_square(
+            block_vec_t& out,
+            std::span<Integer::value_type const> a,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            out.clear();
+            if (a.empty()) return;
+            out.resize(2 * a.size(), 0);
+            square(num_t(out.data(), out.size()), const_num_t(a.data(), a.size()), resource);
+            vec_trim(out);
+        }
+
+        // a *= w; w may use every bit of the word, not only the block bits.
+        inline static constexpr auto vec_mul_word(
+            block_vec_t& a,
+            Integer::value_type w
+        ) -> void {
+            auto c = MachineConfig::acc_t{};
+            for (auto& v : a) {
+                auto const t = MachineConfig::acc_t{v} * w + c;
+                v = static_cast<Integer::value_type>(t & MachineConfig::mask);
+                c = t >> MachineConfig::bits;
+            }
+            // with w above the block mask the carry can take two blocks
+            for (; c; c >>= MachineConfig::bits) {
+                a.push_back(static_cast<Integer::value_type>(c & MachineConfig::mask));
+            }
+            if (w == 0) a.clear();
+        }
+
+        // a += b
+        inline static constexpr auto vec_add(
+            block_vec_t& a,
+            std::span<Integer::value_type const> b
+        ) -> void {
+            a.resize(std::max(a.size(), b.size()) + 1, 0);
+            abs_add(num_t(a.data(), a.size()), const_num_t(b.data(), b.size()));
+            vec_trim(a);
+        }
+
+        inline static constexpr auto vec_add(
+            block_vec_t& a,
+            Integer::value_type b
+        ) -> void {
+            a.push_back(0);
+            abs_add(num_t(a.data(), a.size()), b);
+            vec_trim(a);
+        }
+
+        // a -= b, a >= b
+        inline static constexpr auto vec_sub(
+            block_vec_t& a,
+            std::span<Integer::value_type const> b
+        ) -> void {
+            abs_sub(num_t(a.data(), a.size()), const_num_t(b.data(), b.size()));
+            vec_trim(a);
+        }
+
+        inline static constexpr auto vec_sub(
+            block_vec_t& a,
+            Integer::value_type b
+        ) -> void {
+            abs_sub(num_t(a.data(), a.size()), b);
+            vec_trim(a);
+        }
+
+        // q = a / b, r = a mod b; b != 0. q may be null when only the remainder is needed.
+        inline static constexpr auto vec_divrem(
+            block_vec_t* q,
+            block_vec_t& r,
+            std::span<Integer::value_type const> a,
+            std::span<Integer::value_type const> b,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            auto const qs = a.size() >= b.size() ? a.size() - b.size() + 1 : 0zu;
+            r.assign(b.size(), 0);
+            auto out_q = num_t{};
+            if (q) {
+                q->assign(qs, 0);
+                out_q = num_t(q->data(), q->size());
+            }
+            schoolbook_div(
+                out_q,
+                num_t(r.data(), r.size()),
+                const_num_t(a.data(), a.size()),
+                const_num_t(b.data(), b.size()),
+                resource
+            );
+            if (q) vec_trim(*q);
+            vec_trim(r);
+        }
+
+        inline static constexpr auto vec_to_integer(
+            Integer& out,
+            std::span<Integer::value_type const> v,
+            bool neg = false
+        ) -> void {
+            out.resize(v.size() * MachineConfig::bits);
+            std::copy(v.begin(), v.end(), out.data());
+            out.remove_trailing_empty_blocks();
+            out.set_neg(neg && !out.empty());
+        }
+    } // namespace detail
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_BLOCK_VEC_HPP
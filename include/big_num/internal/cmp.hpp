@@ -4,6 +4,7 @@
 #include "base.hpp"
 #include "number_span.hpp"
 #include "ui.hpp"
+#include <compare>
 #include <type_traits>
 
 namespace big_num::internal {
@@ -306,6 +307,26 @@ namespace big_num::internal {
     ) noexcept -> bool {
         return !less(lhs, rhs);
     }
+
+    // Three-way magnitude comparison that ignores leading zero blocks and
+    // does not depend on the cached bit count of the spans.
+    inline static constexpr auto abs_compare(
+        std::span<MachineConfig::uint_t const> lhs,
+        std::span<MachineConfig::uint_t const> rhs
+    ) noexcept -> std::strong_ordering {
+        auto lsz = lhs.size();
+        auto rsz = rhs.size();
+        while (lsz > 0 && lhs[lsz - 1] == 0) --lsz;
+        while (rsz > 0 && rhs[rsz - 1] == 0) --rsz;
+        if (lsz != rsz) return lsz <=> rsz;
+
+        for (auto i = lsz; i > 0; --i) {
+            auto const tl = lhs[i - 1];
+            auto const tr = rhs[i - 1];
+            if (tl != tr) return tl <=> tr;
+        }
+        return std::strong_ordering::equal;
+    }
 } // namespace big_num::internal
 
 #endif // AMT_BIG_NUM_INTERNAL_CMP_HPP
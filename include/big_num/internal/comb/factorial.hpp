@@ -0,0 +1,231 @@
+#ifndef AMT_BIG_NUM_INTERNAL_COMB_FACTORIAL_HPP
+#define AMT_BIG_NUM_INTERNAL_COMB_FACTORIAL_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include "../prime/sieve.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        /**
+         * out = product of the words in xs, multiplied as a balanced tree so both
+         * sides of every product have about the same size and land in the upper
+         * `mul` tiers. Neighbouring words are first packed while their product
+         * still fits in a block.
+        */
+        inline static constexpr auto word_product(
+            block_vec_t& out,
+            std::span<Integer::value_type const> xs,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            using acc_t = MachineConfig::acc_t;
+            constexpr auto leaf = 16zu;
+
+            auto packed = block_vec_t(resource);
+            packed.reserve(xs.size());
+            auto g = acc_t{1};
+            for (auto x : xs) {
+                if (g * x > MachineConfig::mask) {
+                    packed.push_back(static_cast<Integer::value_type>(g));
+                    g = 1;
+                }
+                g *= x;
+            }
+            packed.push_back(static_cast<Integer::value_type>(g));
+
+            auto rec = [resource](auto&& self, block_vec_t& res, std::span<Integer::value_type const> w) -> void {
+                if (w.size() <= leaf) {
+                    vec_set(res, 1);
+                    for (auto x : w) vec_mul_word(res, x);
+                    return;
+                }
+                auto const h = w.size() / 2;
+                auto lhs = block_vec_t(resource);
+                auto rhs = block_vec_t(resource);
+                self(self, lhs, w.first(h));
+                self(self, rhs, w.subspan(h));
+                vec_mul(res, lhs, rhs, resource);
+            };
+            rec(rec, out, packed);
+        }
+
+        /**
+         * out = product of p^e(p) over the primes; e is a callable giving the exponent.
+         * Primes are grouped by the bits of their exponents, so the result is
+         * (...(P_t^2 * P_(t - 1))^2 ...) * P_0 where P_j is the product of the primes
+         * with bit j set, one balanced product and one squaring per bit.
+        */
+        template <typename Exp>
+        inline static constexpr auto prime_power_product(
+            block_vec_t& out,
+            std::span<Integer::value_type const> primes,
+            Exp&& e,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            auto exps = std::pmr::vector<std::size_t>(resource);
+            exps.reserve(primes.size());
+            auto top = 0zu;
+            for (auto p : primes) {
+                exps.push_back(e(std::size_t{p}));
+                top = std::max(top, exps.back());
+            }
+
+            vec_set(out, 1);
+            auto sel = block_vec_t(resource);
+            auto t = block_vec_t(resource);
+            for (auto j = static_cast<std::size_t>(std::bit_width(top)); j > 0; --j) {
+                vec_mul(t, out, out, resource);
+                std::swap(out, t);
+                sel.clear();
+                for (auto i = 0zu; i < primes.size(); ++i) {
+                    if ((exps[i] >> (j - 1)) & 1) sel.push_back(primes[i]);
+                }
+                if (sel.empty()) continue;
+                word_product(t, sel, resource);
+                auto r = block_vec_t(resource);
+                vec_mul(r, out, t, resource);
+                std::swap(out, r);
+            }
+        }
+
+        // Exponent of p in n!, Legendre's formula.
+        inline static constexpr auto legendre(std::size_t n, std::size_t p) noexcept -> std::size_t {
+            auto e = 0zu;
+            while (n /= p) e += n;
+            return e;
+        }
+
+        /**
+         * Odd part of n!, Luschny's prime swing: oddfact(n) = oddfact(n / 2)^2 * swing(n)
+         * with swing(n) = n! / (n / 2)!^2, whose exponent of p is the number of odd
+         * floor(n / p^i). primes holds at least every odd prime up to n.
+        */
+        inline static constexpr auto odd_factorial(
+            block_vec_t& out,
+            std::size_t n,
+            std::span<Integer::value_type const> primes,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            if (n < 3) {
+                vec_set(out, 1);
+                return;
+            }
+            auto half = block_vec_t(resource);
+            odd_factorial(half, n / 2, primes, resource);
+
+            auto const end = std::upper_bound(primes.begin(), primes.end(), n);
+            auto sel = block_vec_t(resource);
+            for (auto it = primes.begin(); it != end; ++it) {
+                auto const p = std::size_t{*it};
+                if (p == 2) continue;
+                for (auto q = n / p; q > 0; q /= p) {
+                    if (q & 1) sel.push_back(static_cast<Integer::value_type>(p));
+                }
+            }
+            auto sw = block_vec_t(resource);
+            word_product(sw, sel, resource);
+
+            auto t = block_vec_t(resource);
+            vec_mul(t, half, half, resource);
+            vec_mul(out, t, sw, resource);
+        }
+
+        inline static constexpr auto factorial_primes(
+            std::size_t n,
+            std::pmr::memory_resource* resource
+        ) -> std::pmr::vector<Integer::value_type> {
+            auto primes = std::pmr::vector<Integer::value_type>(resource);
+            primes_up_to(primes, n, resource);
+            return primes;
+        }
+    } // namespace detail
+
+    /**
+     * out = n!, n has to fit in a block.
+     * The odd part comes from the prime-swing recursion and the power of two,
+     * 2^(n - popcount(n)), is applied with a single shift at the end.
+    */
+    inline static auto factorial(
+        Integer& out,
+        std::size_t n,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto const primes = detail::factorial_primes(n, resource);
+        auto odd = detail::block_vec_t(resource);
+        detail::odd_factorial(odd, n, primes, resource);
+        auto res = detail::block_vec_t(resource);
+        detail::vec_shift_left(res, odd, n - static_cast<std::size_t>(std::popcount(n)));
+        detail::vec_to_integer(out, res);
+    }
+
+    /**
+     * out = n!! = n (n - 2) (n - 4) ..., n has to fit in a block.
+     * For even n this is 2^(n / 2) (n / 2)!; for odd n = 2k + 1 the exponent of an
+     * odd prime p is e_p((2k + 1)!) - e_p(k!).
+    */
+    inline static auto double_factorial(
+        Integer& out,
+        std::size_t n,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto res = detail::block_vec_t(resource);
+        if (n % 2 == 0) {
+            auto f = Integer{};
+            factorial(f, n / 2, resource);
+            detail::vec_shift_left(res, f.to_span().span(), n / 2);
+        } else {
+            auto const k = (n - 1) / 2;
+            auto const primes = detail::factorial_primes(n, resource);
+            auto const odd = std::span(primes).subspan(primes.empty() ? 0 : 1);
+            detail::prime_power_product(res, odd, [n, k](std::size_t p) {
+                return detail::legendre(n, p) - detail::legendre(k, p);
+            }, resource);
+        }
+        detail::vec_to_integer(out, res);
+    }
+
+    /**
+     * out = C(n, k), zero for k > n; n has to fit in a block.
+     * Kummer: the exponent of p is e_p(n!) - e_p(k!) - e_p((n - k)!), so the result
+     * is built directly from its factorization without any division.
+    */
+    inline static auto binomial(
+        Integer& out,
+        std::size_t n,
+        std::size_t k,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto res = detail::block_vec_t(resource);
+        if (k <= n) {
+            k = std::min(k, n - k);
+            auto const primes = detail::factorial_primes(n, resource);
+            detail::prime_power_product(res, primes, [n, k](std::size_t p) {
+                return detail::legendre(n, p) - detail::legendre(k, p) - detail::legendre(n - k, p);
+            }, resource);
+        }
+        detail::vec_to_integer(out, res);
+    }
+
+    /**
+     * out = n#, the product of all primes p <= n; n has to fit in a block.
+    */
+    inline static auto primorial(
+        Integer& out,
+        std::size_t n,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto const primes = detail::factorial_primes(n, resource);
+        auto res = detail::block_vec_t(resource);
+        detail::word_product(res, primes, resource);
+        detail::vec_to_integer(out, res);
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_COMB_FACTORIAL_HPP
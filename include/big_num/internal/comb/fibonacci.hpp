@@ -0,0 +1,131 @@
+#ifndef AMT_BIG_NUM_INTERNAL_COMB_FIBONACCI_HPP
+#define AMT_BIG_NUM_INTERNAL_COMB_FIBONACCI_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include <bit>
+#include <memory_resource>
+#include <utility>
+
+namespace big_num::internal {
+    namespace detail {
+        // Upper bound on the blocks of F(n + 1), from F(n) < phi^n.
+        inline static constexpr auto fibonacci_blocks(std::size_t n) noexcept -> std::size_t {
+            constexpr auto log2_phi = 0.6942419136306174;
+            auto const bits = static_cast<std::size_t>(static_cast<double>(n + 1) * log2_phi) + 1;
+            return (bits + MachineConfig::bits - 1) / MachineConfig::bits;
+        }
+
+        /**
+         * f = F(n), g = F(n - 1), with F(-1) = 1.
+         * Fast doubling from (F(k), F(k - 1)) with two squarings per bit of n:
+         *   F(2k + 1) = 4 F(k)^2 - F(k - 1)^2 + 2 (-1)^k
+         *   F(2k - 1) = F(k)^2 + F(k - 1)^2
+         *   F(2k)     = F(2k + 1) - F(2k - 1)
+         * Every buffer is reserved for the final size up front, so none of them
+         * grows on the way.
+        */
+        inline static constexpr auto fibonacci_pair(
+            block_vec_t& f,
+            block_vec_t& g,
+            std::size_t n,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            using val_t = Integer::value_type;
+            if (n == 0) {
+                f.clear();
+                vec_set(g, 1);
+                return;
+            }
+
+            // the last squares and the shift or carry on top of them
+            auto const cap = fibonacci_blocks(n) + 4;
+            auto s1 = block_vec_t(resource);
+            auto s0 = block_vec_t(resource);
+            f.reserve(cap);
+            g.reserve(cap);
+            s1.reserve(cap);
+            s0.reserve(cap);
+
+            // k = 1
+            vec_set(f, 1);
+            g.clear();
+            auto odd = true;
+            for (auto i = static_cast<std::size_t>(std::bit_width(n)) - 1; i > 0; --i) {
+                vec_square(s1, f, resource);
+                vec_square(s0, g, resource);
+
+                // f = F(2k + 1)
+                vec_shift_left(f, s1, 2);
+                vec_sub(f, s0);
+                if (odd) vec_sub(f, val_t{2});
+                else vec_add(f, val_t{2});
+
+                // g = F(2k - 1)
+                std::swap(g, s1);
+                vec_add(g, s0);
+
+                odd = (n >> (i - 1)) & 1;
+                if (odd) {
+                    // (F(2k + 1), F(2k))
+                    s1.assign(f.begin(), f.end());
+                    vec_sub(s1, g);
+                    std::swap(g, s1);
+                } else {
+                    // (F(2k), F(2k - 1))
+                    vec_sub(f, g);
+                }
+            }
+        }
+    } // namespace detail
+
+    /**
+     * out = F(n), F(0) = 0, F(1) = 1.
+    */
+    inline static auto fibonacci(
+        Integer& out,
+        std::size_t n,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto f = detail::block_vec_t(resource);
+        auto g = detail::block_vec_t(resource);
+        detail::fibonacci_pair(f, g, n, resource);
+        detail::vec_to_integer(out, f);
+    }
+
+    /**
+     * out_fn = F(n), out_fn1 = F(n + 1)
+    */
+    inline static auto fib2(
+        Integer& out_fn,
+        Integer& out_fn1,
+        std::size_t n,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto f = detail::block_vec_t(resource);
+        auto g = detail::block_vec_t(resource);
+        detail::fibonacci_pair(f, g, n, resource);
+        detail::vec_add(g, f);
+        detail::vec_to_integer(out_fn, f);
+        detail::vec_to_integer(out_fn1, g);
+    }
+
+    /**
+     * out = L(n), L(0) = 2, L(1) = 1; L(n) = F(n) + 2 F(n - 1).
+    */
+    inline static auto lucas(
+        Integer& out,
+        std::size_t n,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto f = detail::block_vec_t(resource);
+        auto g = detail::block_vec_t(resource);
+        detail::fibonacci_pair(f, g, n, resource);
+        detail::vec_add(f, g);
+        detail::vec_add(f, g);
+        detail::vec_to_integer(out, f);
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_COMB_FIBONACCI_HPP
@@ -0,0 +1,141 @@
+#ifndef AMT_BIG_NUM_INTERNAL_DIV_MOD_HPP
+#define AMT_BIG_NUM_INTERNAL_DIV_MOD_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../logical_bitwise.hpp"
+#include "../cmp.hpp"
+#include "schoolbook.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        // Block `i` of `num << shift` where shift < MachineConfig::bits.
+        inline static constexpr auto normalized_block(
+            std::span<Integer::value_type const> num,
+            std::size_t i,
+            std::size_t shift
+        ) noexcept -> Integer::value_type {
+            using acc_t = MachineConfig::acc_t;
+            auto const lo = i > 0 && i - 1 < num.size() ? acc_t{num[i - 1]} : acc_t{};
+            auto const hi = i < num.size() ? acc_t{num[i]} : acc_t{};
+            auto const v = ((hi << MachineConfig::bits) | lo) >> (MachineConfig::bits - shift);
+            return static_cast<Integer::value_type>(v & MachineConfig::mask);
+        }
+    } // namespace detail
+
+    /**
+     * Remainder of a division by a single block. No quotient is written.
+    */
+    inline static constexpr auto mod_1(
+        const_num_t const& num,
+        Integer::value_type den
+    ) noexcept -> Integer::value_type {
+        assert(den > 0);
+        if (num.empty()) return {};
+        if ((den & (den - 1)) == 0) return num[0] & (den - 1);
+        return detail::schoolbook_div_1({}, num.span(), den);
+    }
+
+    /**
+     * out_r = |num| mod |den|
+     * Runs Algorithm D over a window of `den.size() + 1` blocks that slides down the
+     * numerator; every quotient digit is dropped right after it is used, so neither
+     * the quotient nor a normalized copy of the numerator is ever formed.
+     * out_r needs `den.size()` blocks and may alias num or den; it is only
+     * written once the remainder is known.
+     * @returns true if successful; otherwise false if division by zero
+    */
+    inline static constexpr auto mod(
+        num_t out_r,
+        const_num_t const& num,
+        const_num_t const& den,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        using val_t = Integer::value_type;
+
+        auto const u = num.trim_trailing_zeros().span();
+        auto const v = den.trim_trailing_zeros().span();
+        if (v.empty()) return false;
+
+        auto const n = v.size();
+        assert(out_r.size() >= n);
+        auto const clear_from = [&out_r](std::size_t i) {
+            std::fill(out_r.begin() + static_cast<std::ptrdiff_t>(i), out_r.end(), 0);
+        };
+
+        if (u.size() < n || abs_compare(u, v) == std::strong_ordering::less) {
+            if (out_r.data() != u.data()) std::copy(u.begin(), u.end(), out_r.begin());
+            clear_from(u.size());
+            return true;
+        }
+
+        if (n == 1) {
+            out_r[0] = mod_1(const_num_t(u.data(), u.size()), v[0]);
+            clear_from(1);
+            return true;
+        }
+
+        auto const shift = MachineConfig::bits - static_cast<std::size_t>(std::bit_width(v[n - 1]));
+
+        std::pmr::vector<val_t> buff(2 * n + 1, 0, resource);
+        auto vn = std::span(buff.data(), n);
+        auto w = std::span(buff.data() + n, n + 1);
+        shift_left(vn, v, shift);
+        auto const inv = detail::reciprocal_2by1(vn.back());
+
+        // window over the top n + 1 blocks of the normalized numerator
+        auto j = u.size() - n;
+        for (auto i = 0zu; i <= n; ++i) {
+            w[i] = detail::normalized_block(u, j + i, shift);
+        }
+
+        while (true) {
+            detail::schoolbook_div_step(w, vn, inv);
+            if (j == 0) break;
+            --j;
+            std::copy_backward(w.begin(), w.end() - 1, w.end());
+            w[0] = detail::normalized_block(u, j, shift);
+        }
+
+        shift_right(out_r.span().first(n), w.first(n), shift);
+        clear_from(n);
+        return true;
+    }
+
+    /**
+     * The remainder is sized to the divisor and takes the sign of the numerator.
+     * @returns true if successful; otherwise false if division by zero
+    */
+    inline static constexpr auto mod(
+        Integer& out_r,
+        Integer const& num,
+        Integer const& den,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        if (den.empty()) return false;
+        auto const neg = num.is_neg();
+        // out_r may be num or den, so it is resized only after they are read
+        auto r = std::pmr::vector<Integer::value_type>(den.size(), 0, resource);
+        mod(num_t(r.data(), r.size()), num.to_span(), den.to_span(), resource);
+        out_r.resize(r.size() * MachineConfig::bits);
+        std::copy(r.begin(), r.end(), out_r.data());
+        out_r.remove_trailing_empty_blocks();
+        out_r.set_neg(neg && !out_r.empty());
+        return true;
+    }
+
+    inline static constexpr auto mod_1(
+        Integer const& num,
+        Integer::value_type den
+    ) noexcept -> Integer::value_type {
+        return mod_1(num.to_span(), den);
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_DIV_MOD_HPP
@@ -0,0 +1,312 @@
+#ifndef AMT_BIG_NUM_INTERNAL_DIV_PREPARED_HPP
+#define AMT_BIG_NUM_INTERNAL_DIV_PREPARED_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../cmp.hpp"
+#include "../add_sub.hpp"
+#include "../logical_bitwise.hpp"
+#include "../mul/mul.hpp"
+#include "../parallel.hpp"
+#include "reciprocal.hpp"
+#include "schoolbook.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace big_num::internal {
+
+    /**
+     * A divisor with everything that does not depend on the dividend computed
+     * up front: the normalization shift, the normalized blocks and the 2/1
+     * reciprocal of the top block used for the quotient digit estimates.
+     * Divisors of at least `MachineConfig::div_barrett_threshold` blocks also keep
+     * mu = floor(B^(2n) / d), found by Newton iteration; those divide n quotient
+     * blocks at a time with two products that go through the fast `mul` tiers.
+     *
+     * The object is immutable after construction, so one instance can serve
+     * any number of threads as long as each one brings its own scratch.
+    */
+    struct PreparedDivisor {
+        using value_type = Integer::value_type;
+        using size_type = std::size_t;
+
+        PreparedDivisor(
+            const_num_t const& den,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        )
+            : m_norm(resource)
+            , m_mu(resource)
+            , m_neg(den.is_neg())
+        {
+            auto const v = den.trim_trailing_zeros().span();
+            assert(!v.empty() && "divisor cannot be zero");
+            auto const n = v.size();
+
+            m_shift = MachineConfig::bits - static_cast<size_type>(std::bit_width(v[n - 1]));
+            m_norm.resize(n, 0);
+            shift_left(std::span(m_norm), v, m_shift);
+            m_inv = detail::reciprocal_2by1(m_norm.back());
+
+            if (n >= MachineConfig::div_barrett_threshold) {
+                auto mu = detail::block_vec_t(resource);
+                detail::newton_reciprocal(mu, m_norm, resource);
+                m_mu.assign(mu.begin(), mu.end());
+                m_mu.resize(n + 1, 0);
+            }
+        }
+
+        constexpr auto size() const noexcept -> size_type { return m_norm.size(); }
+        constexpr auto shift() const noexcept -> size_type { return m_shift; }
+        constexpr auto reciprocal() const noexcept -> value_type { return m_inv; }
+        constexpr auto normalized() const noexcept -> const_num_t { return { m_norm.data(), m_norm.size() }; }
+        constexpr auto uses_barrett() const noexcept -> bool { return !m_mu.empty(); }
+        constexpr auto is_neg() const noexcept -> bool { return m_neg; }
+
+        // Blocks needed for the quotient of a `num_size` block dividend.
+        constexpr auto quotient_size(size_type num_size) const noexcept -> size_type {
+            return std::max(num_size + 1, size()) - size();
+        }
+
+        // Blocks of scratch `divmod` needs for a dividend of `num_size` blocks.
+        constexpr auto scratch_size(size_type num_size) const noexcept -> size_type {
+            auto const n = size();
+            if (!uses_barrett()) return num_size + 1;
+            auto const chunks = (num_size + n) / n;
+            return num_size + 1 + chunks * n + 6 * n + 3;
+        }
+
+        /**
+         * out_q = |num| / |d|, out_r = |num| mod |d|
+         * out_q needs `quotient_size(num.size())` blocks or can be empty; out_r needs `size()` blocks.
+         * Either may alias num, which is copied into scratch before they are cleared.
+        */
+        constexpr auto divmod(
+            num_t out_q,
+            num_t out_r,
+            const_num_t const& num,
+            num_t scratch,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        ) const -> void {
+            auto const u = num.trim_trailing_zeros().span();
+            auto const n = size();
+            assert(out_r.size() >= n);
+            assert(scratch.size() >= scratch_size(u.size()));
+
+            auto un = scratch.span().first(u.size() + 1);
+            if (u.size() < n || n == 1) {
+                std::copy(u.begin(), u.end(), un.begin());
+            } else {
+                un.back() = shift_left(un.first(u.size()), u, m_shift);
+            }
+
+            std::fill(out_q.begin(), out_q.end(), 0);
+            std::fill(out_r.begin(), out_r.end(), 0);
+
+            if (u.size() < n) {
+                std::copy_n(un.begin(), u.size(), out_r.begin());
+                return;
+            }
+
+            if (n == 1) {
+                out_r[0] = detail::schoolbook_div_1(out_q.span(), un.first(u.size()), m_norm[0] >> m_shift);
+                return;
+            }
+
+            if (uses_barrett()) {
+                divmod_barrett(out_q.span(), un, scratch.span().subspan(un.size()), resource);
+            } else {
+                detail::schoolbook_div_normalized(out_q.span(), un, m_norm, m_inv);
+            }
+
+            shift_right(out_r.span().first(n), un.first(n), m_shift);
+        }
+
+        /**
+         * The quotient takes the sign of num * d and the remainder the sign of num.
+         * Either output may be num.
+        */
+        auto divmod(
+            Integer& out_q,
+            Integer& out_r,
+            Integer const& num,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        ) const -> void {
+            auto const neg = num.is_neg();
+            // the outputs may be num, so they are resized only after it is read
+            auto q = std::pmr::vector<value_type>(quotient_size(num.size()), 0, resource);
+            auto r = std::pmr::vector<value_type>(size(), 0, resource);
+            std::pmr::vector<value_type> scratch(scratch_size(num.size()), 0, resource);
+            divmod(
+                num_t(q.data(), q.size()),
+                num_t(r.data(), r.size()),
+                num.to_span(),
+                std::span(scratch),
+                resource
+            );
+            out_q.resize(q.size() * MachineConfig::bits);
+            std::copy(q.begin(), q.end(), out_q.data());
+            out_r.resize(r.size() * MachineConfig::bits);
+            std::copy(r.begin(), r.end(), out_r.data());
+            out_q.remove_trailing_empty_blocks();
+            out_r.remove_trailing_empty_blocks();
+            out_q.set_neg(neg != m_neg && !out_q.empty());
+            out_r.set_neg(neg && !out_r.empty());
+        }
+
+    private:
+        /**
+         * Treats the normalized dividend as digits of n blocks and divides one digit
+         * at a time: with r < d the next partial dividend x = r * B^n + digit has a
+         * quotient below B^n, estimated as floor(floor(x / B^(n - 1)) * mu / B^(n + 1)),
+         * which is at most two below the true value.
+         * The remainder is left in the low n blocks of un.
+        */
+        constexpr auto divmod_barrett(
+            std::span<value_type> out_q,
+            std::span<value_type> un,
+            std::span<value_type> scratch,
+            std::pmr::memory_resource* resource
+        ) const -> void {
+            auto const n = size();
+            auto const d = normalized();
+            auto const chunks = (un.size() + n - 1) / n;
+
+            auto digits = scratch.first(chunks * n);
+            auto x = scratch.subspan(chunks * n, 2 * n);
+            auto prod = scratch.subspan(chunks * n + 2 * n, 2 * n + 2);
+            auto qd = scratch.subspan(chunks * n + 4 * n + 2, 2 * n + 1);
+
+            std::fill(digits.begin(), digits.end(), 0);
+            std::copy(un.begin(), un.end(), digits.begin());
+            std::fill(x.begin(), x.end(), 0);
+
+            for (auto c = chunks; c > 0; --c) {
+                auto const idx = c - 1;
+                // x = r * B^n + digit
+                std::copy_backward(x.begin(), x.begin() + static_cast<std::ptrdiff_t>(n), x.end());
+                std::copy_n(digits.begin() + static_cast<std::ptrdiff_t>(idx * n), n, x.begin());
+
+                // q = floor(floor(x / B^(n - 1)) * mu / B^(n + 1))
+                // Operands are trimmed first: the leading chunk is mostly zeros and
+                // would otherwise cost a full n-block product.
+                std::fill(prod.begin(), prod.end(), 0);
+                mul_unbalanced(
+                    prod,
+                    const_num_t(x.data() + n - 1, n + 1).trim_trailing_zeros(),
+                    const_num_t(m_mu.data(), m_mu.size()).trim_trailing_zeros(),
+                    resource
+                );
+                auto q = num_t(prod.data() + n + 1, n + 1);
+
+                // x -= q * d
+                std::fill(qd.begin(), qd.end(), 0);
+                mul_unbalanced(qd, q.trim_trailing_zeros(), d, resource);
+                auto xs = num_t(x.data(), x.size());
+                abs_sub(xs, const_num_t(qd.data(), x.size()));
+
+                while (abs_compare(x, d.span()) != std::strong_ordering::less) {
+                    abs_sub(xs, d);
+                    abs_add(q, value_type{1});
+                }
+
+                auto const qb = idx * n;
+                for (auto i = 0zu; i < n && qb + i < out_q.size(); ++i) {
+                    out_q[qb + i] = q[i];
+                }
+            }
+
+            std::fill(un.begin(), un.end(), 0);
+            std::copy_n(x.begin(), n, un.begin());
+        }
+
+        std::pmr::vector<value_type> m_norm;
+        std::pmr::vector<value_type> m_mu;
+        bool m_neg{false};
+        size_type m_shift{};
+        value_type m_inv{};
+    };
+
+    /**
+     * Divides every dividend by the same prepared divisor.
+     * out_q and out_r have to be as long as nums. Work is split across `threads`
+     * (0 = all hardware threads); every worker keeps one scratch buffer for all of
+     * its dividends, so setup and allocation are paid once per worker. The workers
+     * allocate from `resource` at the same time, so with more than one thread it
+     * has to be thread-safe, like the default resource or a
+     * `std::pmr::synchronized_pool_resource`.
+    */
+    inline static auto divmod_batch(
+        std::span<Integer> out_q,
+        std::span<Integer> out_r,
+        std::span<Integer const> nums,
+        PreparedDivisor const& den,
+        std::size_t threads = 1,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        using val_t = Integer::value_type;
+        assert(out_q.size() >= nums.size());
+        assert(out_r.size() >= nums.size());
+
+        parallel_for(nums.size(), threads, [&](std::size_t b, std::size_t e) {
+            auto max_size = 0zu;
+            for (auto i = b; i < e; ++i) max_size = std::max(max_size, nums[i].size());
+
+            std::pmr::vector<val_t> scratch(den.scratch_size(max_size), 0, resource);
+            for (auto i = b; i < e; ++i) {
+                auto const& num = nums[i];
+                auto& q = out_q[i];
+                auto& r = out_r[i];
+                auto const qs = den.quotient_size(num.size());
+                q.resize(qs * MachineConfig::bits);
+                r.resize(den.size() * MachineConfig::bits);
+                den.divmod(
+                    num_t(q.data(), qs),
+                    num_t(r.data(), den.size()),
+                    num.to_span(),
+                    std::span(scratch),
+                    resource
+                );
+                q.remove_trailing_empty_blocks();
+                r.remove_trailing_empty_blocks();
+                q.set_neg(num.is_neg() != den.is_neg() && !q.empty());
+                r.set_neg(num.is_neg() && !r.empty());
+            }
+        });
+    }
+
+    /**
+     * Remainder-only batch; quotient digits are dropped.
+     * `threads` and `resource` as for `divmod_batch`.
+    */
+    inline static auto mod_batch(
+        std::span<Integer> out_r,
+        std::span<Integer const> nums,
+        PreparedDivisor const& den,
+        std::size_t threads = 1,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        using val_t = Integer::value_type;
+        assert(out_r.size() >= nums.size());
+
+        parallel_for(nums.size(), threads, [&](std::size_t b, std::size_t e) {
+            auto max_size = 0zu;
+            for (auto i = b; i < e; ++i) max_size = std::max(max_size, nums[i].size());
+
+            std::pmr::vector<val_t> scratch(den.scratch_size(max_size), 0, resource);
+            for (auto i = b; i < e; ++i) {
+                auto const& num = nums[i];
+                auto& r = out_r[i];
+                r.resize(den.size() * MachineConfig::bits);
+                den.divmod(num_t{}, num_t(r.data(), den.size()), num.to_span(), std::span(scratch), resource);
+                r.remove_trailing_empty_blocks();
+                r.set_neg(num.is_neg() && !r.empty());
+            }
+        });
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_DIV_PREPARED_HPP
@@ -0,0 +1,86 @@
+#ifndef AMT_BIG_NUM_INTERNAL_DIV_RECIPROCAL_HPP
+#define AMT_BIG_NUM_INTERNAL_DIV_RECIPROCAL_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include <cassert>
+#include <compare>
+#include <memory_resource>
+#include <span>
+
+namespace big_num::internal {
+    namespace detail {
+        /**
+         * x = floor(B^(2n) / d) for an n-block d whose top block has its high bit
+         * set, so x has at most n + 1 blocks.
+         * The reciprocal of the top n / 2 + 1 blocks is lifted to n blocks with one
+         * Newton step, x' = x + x * (B^(2n) - d * x) / B^(2n), and the last few units
+         * are fixed against the exact remainder. Every level costs a few products
+         * through the `mul` tiers, so the whole reciprocal is within a constant of
+         * one multiplication; divisors below `MachineConfig::div_barrett_threshold`
+         * blocks are divided directly.
+        */
+        inline static constexpr auto newton_reciprocal(
+            block_vec_t& x,
+            std::span<Integer::value_type const> d,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            using val_t = Integer::value_type;
+            constexpr auto bits = MachineConfig::bits;
+            auto const n = d.size();
+            assert(n > 0 && (d.back() >> (bits - 1)) == 1 && "divisor has to be normalized");
+
+            auto b2n = block_vec_t(2 * n + 1, 0, resource);
+            b2n.back() = 1;
+
+            if (n <= MachineConfig::div_barrett_threshold) {
+                auto r = block_vec_t(resource);
+                vec_divrem(&x, r, b2n, d, resource);
+                return;
+            }
+
+            auto const h = n / 2 + 1;
+            auto xh = block_vec_t(resource);
+            newton_reciprocal(xh, d.last(h), resource);
+
+            // x0 = xh * B^(n - h), e = B^(2n) - d * x0
+            auto x0 = block_vec_t(resource);
+            vec_shift_left(x0, xh, (n - h) * bits);
+            auto p = block_vec_t(resource);
+            vec_mul(p, d, x0, resource);
+
+            auto t = block_vec_t(resource);
+            if (vec_compare(p, b2n) != std::strong_ordering::greater) {
+                vec_sub(b2n, p);
+                vec_mul(t, x0, b2n, resource);
+                vec_shift_right(x, t, 2 * n * bits);
+                vec_add(x, x0);
+            } else {
+                // x0 is too large; x = x0 - ceil(x0 * (d * x0 - B^(2n)) / B^(2n))
+                vec_sub(p, b2n);
+                vec_mul(t, x0, p, resource);
+                vec_shift_right(x, t, 2 * n * bits);
+                vec_add(x, val_t{1});
+                std::swap(x, x0);
+                vec_sub(x, x0);
+            }
+
+            // exact correction, a few units at most
+            b2n.assign(2 * n + 1, 0);
+            b2n.back() = 1;
+            vec_mul(p, d, x, resource);
+            while (vec_compare(p, b2n) == std::strong_ordering::greater) {
+                vec_sub(x, val_t{1});
+                vec_sub(p, d);
+            }
+            vec_sub(b2n, p);
+            while (vec_compare(b2n, d) != std::strong_ordering::less) {
+                vec_add(x, val_t{1});
+                vec_sub(b2n, d);
+            }
+        }
+    } // namespace detail
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_DIV_RECIPROCAL_HPP
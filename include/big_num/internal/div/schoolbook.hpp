@@ -0,0 +1,226 @@
+#ifndef AMT_BIG_NUM_INTERNAL_DIV_SCHOOLBOOK_HPP
+#define AMT_BIG_NUM_INTERNAL_DIV_SCHOOLBOOK_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../logical_bitwise.hpp"
+#include "../cmp.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        /**
+         * Divides the whole span by a single block.
+         * @returns remainder
+        */
+        inline static constexpr auto schoolbook_div_1(
+            std::span<Integer::value_type> out_q,
+            std::span<Integer::value_type const> num,
+            Integer::value_type den
+        ) noexcept -> Integer::value_type {
+            using acc_t = MachineConfig::acc_t;
+            auto c = acc_t{};
+            for (auto i = num.size(); i > 0; --i) {
+                auto const j = i - 1;
+                auto const e = (c << MachineConfig::bits) | num[j];
+                if (!out_q.empty()) out_q[j] = static_cast<Integer::value_type>(e / den);
+                c = e % den;
+            }
+            return static_cast<Integer::value_type>(c);
+        }
+
+        /**
+         * Reciprocal of a normalized block d (top bit set) for `div_2by1`:
+         * v = floor((B^2 - 1) / d) - B
+        */
+        inline static constexpr auto reciprocal_2by1(
+            Integer::value_type d
+        ) noexcept -> Integer::value_type {
+            constexpr auto base = MachineConfig::max;
+            assert((d >> (MachineConfig::bits - 1)) == 1 && "divisor has to be normalized");
+            return static_cast<Integer::value_type>((base * base - 1) / d - base);
+        }
+
+        /**
+         * Möller, Granlund, "Improved division by invariant integers", Algorithm 4.
+         * Divides [u0, u1] by the normalized block d using its reciprocal v; u1 < d.
+        */
+        inline static constexpr auto div_2by1(
+            Integer::value_type u1,
+            Integer::value_type u0,
+            Integer::value_type d,
+            Integer::value_type v
+        ) noexcept -> std::pair<Integer::value_type /*q*/, Integer::value_type /*r*/> {
+            using acc_t = MachineConfig::acc_t;
+            using val_t = Integer::value_type;
+            constexpr auto bits = MachineConfig::bits;
+            constexpr auto mask = MachineConfig::mask;
+
+            auto const p = acc_t{v} * u1 + ((acc_t{u1} << bits) | u0);
+            auto q1 = ((p >> bits) + 1) & mask;
+            auto const q0 = p & mask;
+            auto r = (acc_t{u0} - q1 * d) & mask;
+            if (r > q0) {
+                q1 = (q1 - 1) & mask;
+                r = (r + d) & mask;
+            }
+            if (r >= d) {
+                ++q1;
+                r -= d;
+            }
+            return { static_cast<val_t>(q1), static_cast<val_t>(r) };
+        }
+
+        /**
+         * One step of Algorithm D: un = [u_j, ..., u_(j + n)] -= qhat * vn, where qhat
+         * is estimated from the top blocks and corrected afterwards.
+         * @returns quotient digit
+        */
+        inline static constexpr auto schoolbook_div_step(
+            std::span<Integer::value_type> un,
+            std::span<Integer::value_type const> vn,
+            Integer::value_type inv
+        ) noexcept -> Integer::value_type {
+            using acc_t = MachineConfig::acc_t;
+            using iacc_t = MachineConfig::iacc_t;
+            using val_t = Integer::value_type;
+            constexpr auto base = MachineConfig::max;
+            constexpr auto mask = MachineConfig::mask;
+            constexpr auto bits = MachineConfig::bits;
+
+            auto const n = vn.size();
+            auto const v1 = vn[n - 1];
+            auto const v2 = acc_t{vn[n - 2]};
+
+            // 1. Estimate quotient digit from the top two blocks.
+            auto qhat = acc_t{};
+            auto rhat = acc_t{};
+            if (un[n] >= v1) {
+                qhat = base - 1;
+                rhat = acc_t{un[n - 1]} + v1;
+            } else {
+                auto const [q, r] = div_2by1(un[n], un[n - 1], v1, inv);
+                qhat = q;
+                rhat = r;
+            }
+            while (rhat < base && qhat * v2 > ((rhat << bits) | un[n - 2])) {
+                --qhat;
+                rhat += v1;
+            }
+
+            // 2. Multiply and subtract
+            auto k = iacc_t{};
+            for (auto i = 0zu; i < n; ++i) {
+                auto const p = qhat * vn[i];
+                auto const t = static_cast<iacc_t>(un[i]) - k - static_cast<iacc_t>(p & mask);
+                un[i] = static_cast<val_t>(static_cast<acc_t>(t) & mask);
+                k = static_cast<iacc_t>(p >> bits) - (t >> bits);
+            }
+            auto const t = static_cast<iacc_t>(un[n]) - k;
+            un[n] = static_cast<val_t>(static_cast<acc_t>(t) & mask);
+
+            // 3. Add back if we subtracted one time too many.
+            if (t < 0) {
+                --qhat;
+                auto c = acc_t{};
+                for (auto i = 0zu; i < n; ++i) {
+                    auto const s = acc_t{un[i]} + vn[i] + c;
+                    un[i] = static_cast<val_t>(s & mask);
+                    c = s >> bits;
+                }
+                un[n] = static_cast<val_t>((acc_t{un[n]} + c) & mask);
+            }
+            return static_cast<val_t>(qhat);
+        }
+
+        /**
+         * Knuth, TAOCP Vol. 2, 4.3.1, Algorithm D.
+         * un = [u_0, ..., u_(m + n)] normalized numerator, reduced in place to the remainder.
+         * vn = [v_0, ..., v_(n - 1)] normalized denominator, v_(n - 1) has its top bit set.
+         * out_q receives m + 1 digits; if empty, quotient digits are dropped as they are produced.
+        */
+        inline static constexpr auto schoolbook_div_normalized(
+            std::span<Integer::value_type> out_q,
+            std::span<Integer::value_type> un,
+            std::span<Integer::value_type const> vn,
+            Integer::value_type inv
+        ) noexcept -> void {
+            auto const n = vn.size();
+            assert(n >= 2);
+            assert(un.size() > n);
+
+            for (auto jj = un.size() - n; jj > 0; --jj) {
+                auto const j = jj - 1;
+                auto const q = schoolbook_div_step(un.subspan(j, n + 1), vn, inv);
+                if (!out_q.empty()) out_q[j] = q;
+            }
+        }
+
+        inline static constexpr auto schoolbook_div_normalized(
+            std::span<Integer::value_type> out_q,
+            std::span<Integer::value_type> un,
+            std::span<Integer::value_type const> vn
+        ) noexcept -> void {
+            schoolbook_div_normalized(out_q, un, vn, reciprocal_2by1(vn.back()));
+        }
+    } // namespace detail
+
+    /**
+     * Long division using Knuth's Algorithm D.
+     * out_q needs at least `num.size() - den.size() + 1` blocks or can be empty if
+     * the quotient is not needed; out_r needs at least `den.size()` blocks.
+     * Both outputs are expected to be zero filled.
+     * @returns true of division successful; otherwise false if division by zero
+    */
+    inline static constexpr auto schoolbook_div(
+        num_t out_q,
+        num_t out_r,
+        const_num_t const& num,
+        const_num_t const& den,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        using val_t = Integer::value_type;
+
+        auto const u = num.trim_trailing_zeros().span();
+        auto const v = den.trim_trailing_zeros().span();
+        if (v.empty()) return false;
+        if (u.empty()) return true;
+
+        auto const n = v.size();
+        assert(out_r.size() >= std::min(n, u.size()));
+
+        if (u.size() < n || abs_compare(u, v) == std::strong_ordering::less) {
+            std::copy(u.begin(), u.end(), out_r.begin());
+            return true;
+        }
+
+        assert(out_q.empty() || out_q.size() >= u.size() - n + 1);
+
+        if (n == 1) {
+            out_r[0] = detail::schoolbook_div_1(out_q.span(), u, v[0]);
+            return true;
+        }
+
+        auto const shift = MachineConfig::bits - static_cast<std::size_t>(std::bit_width(v[n - 1]));
+
+        std::pmr::vector<val_t> buff(n + u.size() + 1, 0, resource);
+        auto vn = std::span(buff.data(), n);
+        auto un = std::span(buff.data() + n, u.size() + 1);
+
+        shift_left(vn, v, shift);
+        un.back() = shift_left(un.first(u.size()), u, shift);
+
+        detail::schoolbook_div_normalized(out_q.span(), un, vn);
+
+        shift_right(out_r.span().first(n), un.first(n), shift);
+        return true;
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_DIV_SCHOOLBOOK_HPP
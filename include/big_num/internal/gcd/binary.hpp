@@ -0,0 +1,32 @@
+#ifndef AMT_BIG_NUM_INTERNAL_GCD_BINARY_HPP
+#define AMT_BIG_NUM_INTERNAL_GCD_BINARY_HPP
+
+#include "../base.hpp"
+#include <bit>
+#include <utility>
+
+namespace big_num::internal {
+
+    /**
+     * Stein's binary GCD on a single accumulator; used once both operands
+     * fit in two blocks.
+    */
+    inline static constexpr auto binary_gcd(
+        MachineConfig::acc_t a,
+        MachineConfig::acc_t b
+    ) noexcept -> MachineConfig::acc_t {
+        if (a == 0) return b;
+        if (b == 0) return a;
+
+        auto const k = std::countr_zero(a | b);
+        a >>= std::countr_zero(a);
+        while (b != 0) {
+            b >>= std::countr_zero(b);
+            if (a > b) std::swap(a, b);
+            b -= a;
+        }
+        return a << k;
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_GCD_BINARY_HPP
@@ -0,0 +1,155 @@
+#ifndef AMT_BIG_NUM_INTERNAL_GCD_GCD_HPP
+#define AMT_BIG_NUM_INTERNAL_GCD_GCD_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../cmp.hpp"
+#include "../div/mod.hpp"
+#include "binary.hpp"
+#include "lehmer.hpp"
+#include "hgcd.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace big_num::internal {
+
+    /**
+     * gcd(|a|, |b|) computed in the storage of a and b, both of which are clobbered.
+     * Operands of at least `MachineConfig::hgcd_threshold` blocks are first cut down
+     * with the half-GCD, mid sizes go through Lehmer steps on the leading two blocks
+     * and the last two blocks finish with a binary GCD. The half-GCD works in one
+     * buffer sized for the first call; other temporaries come from `resource`.
+     * @returns the gcd as a trimmed view into either a or b
+    */
+    inline static constexpr auto gcd_inplace(
+        num_t a,
+        num_t b,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> num_t {
+        using acc_t = MachineConfig::acc_t;
+        using val_t = Integer::value_type;
+        constexpr auto bits = MachineConfig::bits;
+
+        auto x = detail::gcd_trim(a.span());
+        auto y = detail::gcd_trim(b.span());
+        auto rem = std::pmr::vector<val_t>(resource);
+        auto hgcd_buff = std::pmr::vector<val_t>(resource);
+        auto hgcd_cap = 0zu;
+
+        auto as_acc = [](std::span<val_t const> v) {
+            auto r = acc_t{};
+            for (auto i = v.size(); i > 0; --i) r = (r << bits) | v[i - 1];
+            return r;
+        };
+        auto write_acc = [](std::span<val_t> out, acc_t v) {
+            auto n = 0zu;
+            for (; v != 0; ++n) {
+                out[n] = static_cast<val_t>(v & MachineConfig::mask);
+                v >>= bits;
+            }
+            return out.first(n);
+        };
+
+        while (true) {
+            if (y.empty()) return num_t(x.data(), x.size());
+            if (x.empty()) return num_t(y.data(), y.size());
+
+            if (x.size() <= 2 && y.size() <= 2) {
+                auto const g = binary_gcd(as_acc(x), as_acc(y));
+                x = write_acc(x, g);
+                return num_t(x.data(), x.size());
+            }
+
+            if (x.size() == 1 || y.size() == 1) {
+                if (x.size() != 1) std::swap(x, y);
+                auto const r = mod_1(const_num_t(y.data(), y.size()), x[0]);
+                auto const g = binary_gcd(acc_t{x[0]}, acc_t{r});
+                x[0] = static_cast<val_t>(g);
+                return num_t(x.data(), x.size());
+            }
+
+            auto const n = std::max(detail::vec_bits(x), detail::vec_bits(y));
+
+            if (std::max(x.size(), y.size()) >= MachineConfig::hgcd_threshold) {
+                // Sizes only shrink from here on, so one allocation covers every round.
+                if (hgcd_buff.empty()) {
+                    hgcd_cap = std::max(x.size(), y.size()) + 1;
+                    hgcd_buff.resize(detail::GcdMatrix::storage_size(hgcd_cap) + detail::hgcd_scratch_size(hgcd_cap - 1), 0);
+                }
+                auto const storage = std::span(hgcd_buff);
+                auto mat = detail::GcdMatrix(storage, hgcd_cap);
+                if (detail::hgcd(x, y, mat, storage.subspan(detail::GcdMatrix::storage_size(hgcd_cap)), resource)) {
+                    continue;
+                }
+            }
+
+            // n > 2 * bits since one operand has more than two blocks
+            auto const p = n - 2 * bits;
+            auto const w = detail::gcd_word_hgcd(detail::gcd_top_bits(x, p), detail::gcd_top_bits(y, p));
+            if (!w.is_identity()) {
+                detail::gcd_apply_word(x, y, w);
+                x = detail::gcd_trim(x);
+                y = detail::gcd_trim(y);
+                continue;
+            }
+
+            // The leading blocks are too far apart for a Lehmer step; divide instead.
+            if (abs_compare(x, y) == std::strong_ordering::less) std::swap(x, y);
+            rem.assign(y.size(), 0);
+            mod(num_t(rem.data(), rem.size()), const_num_t(x.data(), x.size()), const_num_t(y.data(), y.size()), resource);
+            std::fill(std::copy(rem.begin(), rem.end(), x.begin()), x.end(), 0);
+            x = detail::gcd_trim(x);
+        }
+    }
+
+    /**
+     * out = gcd(|a|, |b|)
+     * out needs `std::max(a.size(), b.size())` blocks.
+     * @returns number of blocks in the gcd
+    */
+    inline static constexpr auto gcd(
+        num_t out,
+        const_num_t const& a,
+        const_num_t const& b,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> std::size_t {
+        using val_t = Integer::value_type;
+        auto const ta = a.trim_trailing_zeros().span();
+        auto const tb = b.trim_trailing_zeros().span();
+        assert(out.size() >= std::max(ta.size(), tb.size()));
+
+        std::pmr::vector<val_t> buff(ta.size() + tb.size(), 0, resource);
+        std::copy(ta.begin(), ta.end(), buff.begin());
+        std::copy(tb.begin(), tb.end(), buff.begin() + static_cast<std::ptrdiff_t>(ta.size()));
+
+        auto const g = gcd_inplace(
+            num_t(buff.data(), ta.size()),
+            num_t(buff.data() + ta.size(), tb.size()),
+            resource
+        );
+        std::fill(std::copy(g.begin(), g.end(), out.begin()), out.end(), 0);
+        return g.size();
+    }
+
+    /**
+     * The result is always non-negative.
+    */
+    inline static constexpr auto gcd(
+        Integer& out,
+        Integer const& a,
+        Integer const& b,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto const size = std::max(a.size(), b.size());
+        out.resize(size * MachineConfig::bits);
+        out.set_neg(false);
+        gcd(num_t(out.data(), size), a.to_span(), b.to_span(), resource);
+        out.remove_trailing_empty_blocks();
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_GCD_GCD_HPP
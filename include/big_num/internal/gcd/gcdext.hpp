@@ -0,0 +1,166 @@
+#ifndef AMT_BIG_NUM_INTERNAL_GCD_GCDEXT_HPP
+#define AMT_BIG_NUM_INTERNAL_GCD_GCDEXT_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../cmp.hpp"
+#include "../div/schoolbook.hpp"
+#include "lehmer.hpp"
+#include "hgcd.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        /**
+         * Rows of the accumulated reduction matrix M; (a; b) = M * (alpha; beta) and
+         * alpha = m11 * a - m01 * b, beta = m00 * b - m10 * a.
+         * The entries never exceed the inputs, so caller storage for entries of one
+         * block more than the larger input is enough.
+         * The row that belongs to a cofactor nobody asked for is never updated.
+        */
+        struct GcdCofactors {
+            GcdMatrix mat;
+            bool want_s;
+            bool want_t;
+
+            constexpr GcdCofactors(std::span<Integer::value_type> storage, std::size_t cap, bool s, bool t) noexcept
+                : mat(storage, cap)
+                , want_s(s)
+                , want_t(t)
+            {}
+
+            template <typename... Args>
+            constexpr auto update(Args&&... args) -> void {
+                if (want_t) gcd_row_mul(mat, 0, args...);
+                if (want_s) gcd_row_mul(mat, 1, args...);
+            }
+        };
+
+        // Blocks of scratch `gcdext_reduce` needs for operands of at most n blocks.
+        inline static constexpr auto gcdext_scratch_size(std::size_t n) noexcept -> std::size_t {
+            return GcdMatrix::storage_size(n + 1) + hgcd_scratch_size(n);
+        }
+
+        /**
+         * Same reduction as `gcd_inplace`, with the cofactor rows tracked alongside.
+         * a and b are trimmed views that shrink in place; runs until one of them is zero.
+         * scratch needs `gcdext_scratch_size` blocks.
+         * @returns true if the gcd ended up in a; otherwise it is in b
+        */
+        inline static constexpr auto gcdext_reduce(
+            std::span<Integer::value_type>& a,
+            std::span<Integer::value_type>& b,
+            GcdCofactors& cf,
+            std::span<Integer::value_type> scratch,
+            std::pmr::memory_resource* resource
+        ) -> bool {
+            constexpr auto bits = MachineConfig::bits;
+            a = gcd_trim(a);
+            b = gcd_trim(b);
+
+            while (true) {
+                if (b.empty()) return true;
+                if (a.empty()) return false;
+
+                auto const n = std::max(vec_bits(a), vec_bits(b));
+
+                if (std::max(a.size(), b.size()) >= MachineConfig::hgcd_threshold) {
+                    auto rest = scratch;
+                    auto const cap = std::max(a.size(), b.size()) + 1;
+                    auto mat = GcdMatrix(gcd_take(rest, GcdMatrix::storage_size(cap)), cap);
+                    if (hgcd(a, b, mat, rest, resource)) {
+                        cf.update(mat, rest, resource);
+                        continue;
+                    }
+                }
+
+                if (n >= 2 * bits) {
+                    auto const p = n - 2 * bits;
+                    auto const w = gcd_word_hgcd(gcd_top_bits(a, p), gcd_top_bits(b, p));
+                    if (!w.is_identity()) {
+                        gcd_apply_word(a, b, w);
+                        a = gcd_trim(a);
+                        b = gcd_trim(b);
+                        cf.update(w);
+                        continue;
+                    }
+                }
+
+                auto const a_big = abs_compare(a, b) != std::strong_ordering::less;
+                auto& big = a_big ? a : b;
+                auto& small = a_big ? b : a;
+                auto rest = scratch;
+                auto q = gcd_take(rest, big.size() - small.size() + 1);
+                auto r = gcd_take(rest, small.size());
+                std::fill(q.begin(), q.end(), 0);
+                std::fill(r.begin(), r.end(), 0);
+                schoolbook_div(
+                    num_t(q.data(), q.size()),
+                    num_t(r.data(), r.size()),
+                    const_num_t(big.data(), big.size()),
+                    const_num_t(small.data(), small.size()),
+                    resource
+                );
+                big = gcd_assign(big, gcd_trim(r));
+                cf.update(std::span<Integer::value_type const>(gcd_trim(q)), a_big, rest, resource);
+            }
+        }
+    } // namespace detail
+
+    /**
+     * g = gcd(a, b) = s * a + t * b with g >= 0.
+     * Pass nullptr for a cofactor that is not needed; its half of the reduction
+     * matrix is then never formed, which saves up to half of the cofactor work.
+     * The cofactors are the ones the reduction produces and are not normalized any further.
+    */
+    inline static constexpr auto gcdext(
+        Integer& g,
+        Integer* s,
+        Integer* t,
+        Integer const& a,
+        Integer const& b,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        using val_t = Integer::value_type;
+        auto const sa = a.to_span().trim_trailing_zeros();
+        auto const sb = b.to_span().trim_trailing_zeros();
+        auto const n = std::max(sa.size(), sb.size());
+        auto const cap = n + 1;
+        auto const a_neg = a.is_neg();
+        auto const b_neg = b.is_neg();
+
+        std::pmr::vector<val_t> buff(sa.size() + sb.size() + detail::GcdMatrix::storage_size(cap) + detail::gcdext_scratch_size(n), 0, resource);
+        auto rest = std::span(buff);
+        auto x = detail::gcd_take(rest, sa.size());
+        auto y = detail::gcd_take(rest, sb.size());
+        std::copy(sa.begin(), sa.end(), x.begin());
+        std::copy(sb.begin(), sb.end(), y.begin());
+
+        auto cf = detail::GcdCofactors(detail::gcd_take(rest, detail::GcdMatrix::storage_size(cap)), cap, s != nullptr, t != nullptr);
+        auto const in_a = detail::gcdext_reduce(x, y, cf, rest, resource);
+
+        // g = alpha = m11 * a - m01 * b or g = beta = m00 * b - m10 * a
+        auto const& m = cf.mat.m;
+        if (s) detail::vec_to_integer(*s, in_a ? m[3] : m[2], in_a == a_neg);
+        if (t) detail::vec_to_integer(*t, in_a ? m[1] : m[0], in_a != b_neg);
+        detail::vec_to_integer(g, in_a ? x : y, false);
+    }
+
+    inline static constexpr auto gcdext(
+        Integer& g,
+        Integer& s,
+        Integer& t,
+        Integer const& a,
+        Integer const& b,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        gcdext(g, &s, &t, a, b, resource);
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_GCD_GCDEXT_HPP
@@ -0,0 +1,412 @@
+#ifndef AMT_BIG_NUM_INTERNAL_GCD_HGCD_HPP
+#define AMT_BIG_NUM_INTERNAL_GCD_HGCD_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include "../cmp.hpp"
+#include "../add_sub.hpp"
+#include "../logical_bitwise.hpp"
+#include "../div/schoolbook.hpp"
+#include "../mul/mul.hpp"
+#include "lehmer.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        /**
+         * Multi-block reduction matrix, (a; b) = M * (alpha; beta) with non-negative
+         * entries and det(M) = 1. Entries are stored row-major: m00, m01, m10, m11,
+         * each as a trimmed view into `cap` blocks of caller storage.
+        */
+        struct GcdMatrix {
+            std::array<std::span<Integer::value_type>, 4> m;
+            std::size_t cap;
+
+            // Blocks of storage for entries of at most `cap` blocks.
+            static constexpr auto storage_size(std::size_t cap) noexcept -> std::size_t {
+                return 4 * cap;
+            }
+
+            // Identity matrix over `storage`, which needs `storage_size(cap)` blocks.
+            constexpr GcdMatrix(std::span<Integer::value_type> storage, std::size_t cap) noexcept
+                : cap(cap)
+            {
+                assert(storage.size() >= storage_size(cap));
+                for (auto i = 0zu; i < 4; ++i) m[i] = storage.subspan(i * cap, 0);
+                m[0] = storage.subspan(0, 1);
+                m[0][0] = 1;
+                m[3] = storage.subspan(3 * cap, 1);
+                m[3][0] = 1;
+            }
+
+            constexpr auto storage(std::size_t i) const noexcept -> std::span<Integer::value_type> {
+                return { m[i].data(), cap };
+            }
+        };
+
+        // Splits the first n blocks off the scratch span.
+        inline static constexpr auto gcd_take(
+            std::span<Integer::value_type>& scratch,
+            std::size_t n
+        ) noexcept -> std::span<Integer::value_type> {
+            assert(n <= scratch.size() && "half-GCD scratch is too small");
+            auto const r = scratch.first(n);
+            scratch = scratch.subspan(n);
+            return r;
+        }
+
+        // Copies v to the front of buf and returns it as a trimmed view.
+        inline static constexpr auto gcd_assign(
+            std::span<Integer::value_type> buf,
+            std::span<Integer::value_type const> v
+        ) noexcept -> std::span<Integer::value_type> {
+            assert(v.size() <= buf.size());
+            std::copy(v.begin(), v.end(), buf.begin());
+            return buf.first(v.size());
+        }
+
+        // a * b in the front of buf, which needs a.size() + b.size() blocks.
+        inline static constexpr auto gcd_mul(
+            std::span<Integer::value_type> buf,
+            std::span<Integer::value_type const> a,
+            std::span<Integer::value_type const> b,
+            std::pmr::memory_resource* resource
+        ) -> std::span<Integer::value_type> {
+            if (a.empty() || b.empty()) return buf.first(0);
+            auto const r = buf.first(a.size() + b.size());
+            std::fill(r.begin(), r.end(), 0);
+            mul_unbalanced(num_t(r.data(), r.size()), const_num_t(a.data(), a.size()), const_num_t(b.data(), b.size()), resource);
+            return gcd_trim(r);
+        }
+
+        // a + b, where a is a trimmed view at the front of buf.
+        inline static constexpr auto gcd_add(
+            std::span<Integer::value_type> buf,
+            std::span<Integer::value_type> a,
+            std::span<Integer::value_type const> b
+        ) noexcept -> std::span<Integer::value_type> {
+            auto const n = std::max(a.size(), b.size()) + 1;
+            assert(a.data() == buf.data() && n <= buf.size());
+            std::fill(buf.begin() + static_cast<std::ptrdiff_t>(a.size()), buf.begin() + static_cast<std::ptrdiff_t>(n), 0);
+            abs_add(num_t(buf.data(), n), const_num_t(b.data(), b.size()));
+            return gcd_trim(buf.first(n));
+        }
+
+        // a - b in place for a >= b.
+        inline static constexpr auto gcd_sub(
+            std::span<Integer::value_type> a,
+            std::span<Integer::value_type const> b
+        ) noexcept -> std::span<Integer::value_type> {
+            abs_sub(num_t(a.data(), a.size()), const_num_t(b.data(), b.size()));
+            return gcd_trim(a);
+        }
+
+        // [x, y] <- [x, y] * N for row `row` of `mat`
+        inline static constexpr auto gcd_row_mul(
+            GcdMatrix& mat,
+            std::size_t row,
+            GcdMatrix const& n,
+            std::span<Integer::value_type> scratch,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            auto& x = mat.m[2 * row];
+            auto& y = mat.m[2 * row + 1];
+            auto const len = std::max(x.size(), y.size()) + n.cap + 1;
+            auto b0 = gcd_take(scratch, len);
+            auto b1 = gcd_take(scratch, len);
+            auto b2 = gcd_take(scratch, len);
+
+            auto t0 = gcd_mul(b0, x, n.m[0], resource);
+            auto t1 = gcd_mul(b1, y, n.m[2], resource);
+            t0 = gcd_add(b0, t0, t1);
+            auto t2 = gcd_mul(b2, x, n.m[1], resource);
+            t1 = gcd_mul(b1, y, n.m[3], resource);
+            t2 = gcd_add(b2, t2, t1);
+            x = gcd_assign(mat.storage(2 * row), t0);
+            y = gcd_assign(mat.storage(2 * row + 1), t2);
+        }
+
+        // [x, y] <- [x, y] * W in a single pass; the entries of W are below 2^(bits - 1).
+        inline static constexpr auto gcd_row_mul(
+            GcdMatrix& mat,
+            std::size_t row,
+            GcdWordMatrix const& w
+        ) noexcept -> void {
+            using acc_t = MachineConfig::acc_t;
+            using val_t = Integer::value_type;
+            constexpr auto bits = MachineConfig::bits;
+            constexpr auto mask = MachineConfig::mask;
+
+            auto& x = mat.m[2 * row];
+            auto& y = mat.m[2 * row + 1];
+            auto const n = std::max(x.size(), y.size()) + 1;
+            assert(n <= mat.cap);
+            auto const bx = mat.storage(2 * row).first(n);
+            auto const by = mat.storage(2 * row + 1).first(n);
+            std::fill(bx.begin() + static_cast<std::ptrdiff_t>(x.size()), bx.end(), 0);
+            std::fill(by.begin() + static_cast<std::ptrdiff_t>(y.size()), by.end(), 0);
+
+            auto cx = acc_t{};
+            auto cy = acc_t{};
+            for (auto i = 0zu; i < n; ++i) {
+                auto const xi = acc_t{bx[i]};
+                auto const yi = acc_t{by[i]};
+                auto const tx = xi * w.m00 + yi * w.m10 + cx;
+                auto const ty = xi * w.m01 + yi * w.m11 + cy;
+                bx[i] = static_cast<val_t>(tx & mask);
+                by[i] = static_cast<val_t>(ty & mask);
+                cx = tx >> bits;
+                cy = ty >> bits;
+            }
+            x = gcd_trim(bx);
+            y = gcd_trim(by);
+        }
+
+        // [x, y] <- [x, y] * [[1, q], [0, 1]] if a_big; otherwise [x, y] * [[1, 0], [q, 1]]
+        inline static constexpr auto gcd_row_mul(
+            GcdMatrix& mat,
+            std::size_t row,
+            std::span<Integer::value_type const> q,
+            bool a_big,
+            std::span<Integer::value_type> scratch,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            auto const src = a_big ? 2 * row : 2 * row + 1;
+            auto const dst = a_big ? 2 * row + 1 : 2 * row;
+            auto const t = gcd_mul(gcd_take(scratch, mat.m[src].size() + q.size()), mat.m[src], q, resource);
+            mat.m[dst] = gcd_add(mat.storage(dst), mat.m[dst], t);
+        }
+
+        // M <- M * N
+        inline static constexpr auto gcd_mat_mul(
+            GcdMatrix& mat,
+            GcdMatrix const& n,
+            std::span<Integer::value_type> scratch,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            gcd_row_mul(mat, 0, n, scratch, resource);
+            gcd_row_mul(mat, 1, n, scratch, resource);
+        }
+
+        inline static constexpr auto gcd_mat_mul(
+            GcdMatrix& mat,
+            GcdWordMatrix const& w
+        ) noexcept -> void {
+            gcd_row_mul(mat, 0, w);
+            gcd_row_mul(mat, 1, w);
+        }
+
+        // (a; b) <- M^-1 * (a; b) = (m11 * a - m01 * b; m00 * b - m10 * a), in place
+        inline static constexpr auto gcd_apply(
+            std::span<Integer::value_type>& a,
+            std::span<Integer::value_type>& b,
+            GcdMatrix const& mat,
+            std::span<Integer::value_type> scratch,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            auto const& m = mat.m;
+            auto const len = std::max(a.size(), b.size()) + mat.cap;
+            auto b0 = gcd_take(scratch, len);
+            auto b1 = gcd_take(scratch, len);
+            auto b2 = gcd_take(scratch, len);
+
+            auto t0 = gcd_mul(b0, m[3], a, resource);
+            auto t1 = gcd_mul(b1, m[1], b, resource);
+            t0 = gcd_sub(t0, t1);
+
+            auto t2 = gcd_mul(b2, m[0], b, resource);
+            t1 = gcd_mul(b1, m[2], a, resource);
+            t2 = gcd_sub(t2, t1);
+
+            // alpha <= a and beta <= b, so both fit the blocks they replace
+            a = gcd_assign(a, t0);
+            b = gcd_assign(b, t2);
+        }
+
+        /**
+         * One Euclidean step on the larger operand that keeps both above 2^s.
+         * When the full remainder would drop to s bits or below, the quotient is
+         * lowered by one instead; no step at all is taken when even that would.
+         * @returns false if no step was taken
+        */
+        inline static constexpr auto hgcd_step(
+            std::span<Integer::value_type>& a,
+            std::span<Integer::value_type>& b,
+            std::size_t s,
+            GcdMatrix& mat,
+            std::span<Integer::value_type> scratch,
+            std::pmr::memory_resource* resource
+        ) -> bool {
+            auto const a_big = abs_compare(a, b) != std::strong_ordering::less;
+            auto& big = a_big ? a : b;
+            auto& small = a_big ? b : a;
+            if (vec_bits(small) <= s) return false;
+
+            auto q = gcd_take(scratch, big.size() - small.size() + 1);
+            auto const rbuf = gcd_take(scratch, small.size() + 1);
+            std::fill(q.begin(), q.end(), 0);
+            std::fill(rbuf.begin(), rbuf.end(), 0);
+            schoolbook_div(
+                num_t(q.data(), q.size()),
+                num_t(rbuf.data(), small.size()),
+                const_num_t(big.data(), big.size()),
+                const_num_t(small.data(), small.size()),
+                resource
+            );
+            q = gcd_trim(q);
+            auto r = gcd_trim(rbuf);
+
+            if (vec_bits(r) <= s) {
+                if (q.size() == 1 && q[0] == 1) return false;
+                abs_sub(num_t(q.data(), q.size()), Integer::value_type{1});
+                q = gcd_trim(q);
+                r = gcd_add(rbuf, r, small);
+            }
+            big = gcd_assign(big, r);
+
+            // a = q * b + r: M <- M * [[1, q], [0, 1]]; b = q * a + r: M <- M * [[1, 0], [q, 1]]
+            gcd_row_mul(mat, 0, q, a_big, scratch, resource);
+            gcd_row_mul(mat, 1, q, a_big, scratch, resource);
+            return true;
+        }
+
+        /**
+         * Lehmer steps on the leading blocks while the operands are well above 2^s,
+         * single Euclidean steps once they get close.
+        */
+        inline static constexpr auto hgcd_lehmer(
+            std::span<Integer::value_type>& a,
+            std::span<Integer::value_type>& b,
+            std::size_t s,
+            GcdMatrix& mat,
+            std::span<Integer::value_type> scratch,
+            std::pmr::memory_resource* resource
+        ) -> bool {
+            constexpr auto bits = MachineConfig::bits;
+            auto progress = false;
+            while (true) {
+                auto const n = std::max(vec_bits(a), vec_bits(b));
+                // A word step leaves both operands above 2^(n - bits).
+                if (n >= 2 * bits && n > s + bits) {
+                    auto const p = n - 2 * bits;
+                    auto const w = gcd_word_hgcd(gcd_top_bits(a, p), gcd_top_bits(b, p));
+                    if (!w.is_identity()) {
+                        gcd_apply_word(a, b, w);
+                        a = gcd_trim(a);
+                        b = gcd_trim(b);
+                        gcd_mat_mul(mat, w);
+                        progress = true;
+                        continue;
+                    }
+                }
+                if (!hgcd_step(a, b, s, mat, scratch, resource)) break;
+                progress = true;
+            }
+            return progress;
+        }
+
+        /**
+         * Blocks of scratch `hgcd` needs for operands of at most n blocks, with
+         * entries of `mat` of at most n + 1 blocks.
+        */
+        inline static constexpr auto hgcd_scratch_size(std::size_t n) noexcept -> std::size_t {
+            // quotient and remainder of a step, then the product with a matrix entry
+            auto const step = 4 * n + 4;
+            if (n < MachineConfig::hgcd_threshold || n < 2) return step;
+            // Both shifted operands and the second matrix are live across a recursive call
+            // on at most (n + 1) / 2 blocks or the three products of a matrix update.
+            auto const half = (n + 1) / 2;
+            auto const update = 3 * (2 * n + 2);
+            return 2 * n + GcdMatrix::storage_size(half + 1) + std::max(hgcd_scratch_size(half), update);
+        }
+
+        /**
+         * Half-GCD, following Möller, "On Schönhage's algorithm and subquadratic
+         * integer gcd computation".
+         * Reduces (a, b) in place to (alpha, beta) = M^-1 * (a, b). Both stay above 2^s,
+         * with s = n / 2 + 1 and n the bit length of the larger input; a and b are
+         * trimmed views and shrink with the values.
+         * The matrix comes from two recursive calls, on the top half and then on the
+         * top half of what is left; they are applied to the full numbers with the
+         * `mul` tiers. Because alpha and beta are larger than the entries of M
+         * (alpha * beta > max(a, b)), a matrix found for the truncated operands keeps
+         * the full ones positive.
+         * mat has to be the identity on entry, with room for entries of
+         * max(a.size(), b.size()) + 1 blocks; scratch needs `hgcd_scratch_size` blocks.
+         * @returns false if no reduction was possible
+        */
+        inline static constexpr auto hgcd(
+            std::span<Integer::value_type>& a,
+            std::span<Integer::value_type>& b,
+            GcdMatrix& mat,
+            std::span<Integer::value_type> scratch,
+            std::pmr::memory_resource* resource
+        ) -> bool {
+            constexpr auto bits = MachineConfig::bits;
+            auto const n = std::max(vec_bits(a), vec_bits(b));
+            auto const s = n / 2 + 1;
+            if (std::min(vec_bits(a), vec_bits(b)) <= s) return false;
+
+            if (MachineConfig::size(n) < MachineConfig::hgcd_threshold || MachineConfig::size(n) < 2) {
+                return hgcd_lehmer(a, b, s, mat, scratch, resource);
+            }
+
+            // The top bits of a and b from bit p on, in scratch.
+            auto shifted = [](std::span<Integer::value_type>& buf, std::span<Integer::value_type> v, std::size_t p) {
+                auto const out = gcd_take(buf, v.size() - p / bits);
+                shift_right(out, std::span<Integer::value_type const>(v).subspan(p / bits), p % bits);
+                return gcd_trim(out);
+            };
+
+            auto progress = false;
+
+            // 1. Reduce the top half; leaves about 3n/4 bits. mat is the identity, so the
+            //    recursive call can build its matrix there.
+            {
+                auto rest = scratch;
+                auto ta = shifted(rest, a, n / 2);
+                auto tb = shifted(rest, b, n / 2);
+                if (hgcd(ta, tb, mat, rest, resource)) {
+                    gcd_apply(a, b, mat, rest, resource);
+                    progress = true;
+                }
+            }
+
+            while (std::max(vec_bits(a), vec_bits(b)) > (3 * n) / 4 + 1) {
+                if (!hgcd_step(a, b, s, mat, scratch, resource)) return progress;
+                progress = true;
+            }
+
+            // 2. Möller's second split, p = 2s - n2 + 1: the top m = n2 - p bits reduce to
+            //    above 2^s' with s' = m / 2 + 1 = n2 - s, and the entries of m2 stay below
+            //    2^(m - s') = 2^(s' - 1). On the full pair the dropped bits move each value by
+            //    less than 2^(p + s' - 1), so both stay above 2^(p + s') - 2^(p + s' - 1) = 2^s.
+            {
+                auto rest = scratch;
+                auto const n2 = std::max(vec_bits(a), vec_bits(b));
+                auto const p = 2 * s - n2 + 1;
+                auto ta = shifted(rest, a, p);
+                auto tb = shifted(rest, b, p);
+                auto const cap = std::max(ta.size(), tb.size()) + 1;
+                auto m2 = GcdMatrix(gcd_take(rest, GcdMatrix::storage_size(cap)), cap);
+                if (hgcd(ta, tb, m2, rest, resource)) {
+                    gcd_apply(a, b, m2, rest, resource);
+                    gcd_mat_mul(mat, m2, rest, resource);
+                    progress = true;
+                }
+            }
+
+            while (hgcd_step(a, b, s, mat, scratch, resource)) progress = true;
+            return progress;
+        }
+    } // namespace detail
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_GCD_HGCD_HPP
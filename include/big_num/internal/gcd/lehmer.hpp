@@ -0,0 +1,145 @@
+#ifndef AMT_BIG_NUM_INTERNAL_GCD_LEHMER_HPP
+#define AMT_BIG_NUM_INTERNAL_GCD_LEHMER_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <span>
+
+namespace big_num::internal {
+    namespace detail {
+        /**
+         * Reduction matrix with entries below B / 2.
+         * (a; b) = M * (alpha; beta); M has non-negative entries and det(M) = 1, so
+         * gcd(a, b) = gcd(alpha, beta), alpha <= a and beta <= b.
+        */
+        struct GcdWordMatrix {
+            MachineConfig::acc_t m00{1};
+            MachineConfig::acc_t m01{};
+            MachineConfig::acc_t m10{};
+            MachineConfig::acc_t m11{1};
+
+            constexpr auto is_identity() const noexcept -> bool {
+                return m01 == 0 && m10 == 0;
+            }
+        };
+
+        inline static constexpr auto gcd_trim(
+            std::span<Integer::value_type> a
+        ) noexcept -> std::span<Integer::value_type> {
+            auto n = a.size();
+            while (n > 0 && a[n - 1] == 0) --n;
+            return a.first(n);
+        }
+
+        // Bits [p, p + 2 * bits) of a.
+        inline static constexpr auto gcd_top_bits(
+            std::span<Integer::value_type const> a,
+            std::size_t p
+        ) noexcept -> MachineConfig::acc_t {
+            using acc_t = MachineConfig::acc_t;
+            constexpr auto bits = MachineConfig::bits;
+            auto const block = p / bits;
+            auto const index = p % bits;
+            auto get = [a](std::size_t i) { return i < a.size() ? acc_t{a[i]} : acc_t{}; };
+            auto v = get(block) >> index;
+            v |= get(block + 1) << (bits - index);
+            v |= get(block + 2) << (2 * bits - index);
+            return v & ((acc_t{1} << (2 * bits)) - 1);
+        }
+
+        /**
+         * Lehmer's step on the leading 2 * bits of both operands.
+         * Euclid runs on the truncated values a and b while both stay at or above 2^(bits + 1).
+         * Then alpha * beta > max(a, b), so every entry of M stays below the matching
+         * remainder. Applying M to the full numbers therefore keeps both results
+         * positive, and no quotient check (Collins/Jebelean) is needed.
+         * Entries end up below 2^(bits - 1).
+        */
+        inline static constexpr auto gcd_word_hgcd(
+            MachineConfig::acc_t a,
+            MachineConfig::acc_t b
+        ) noexcept -> GcdWordMatrix {
+            using acc_t = MachineConfig::acc_t;
+            constexpr auto limit = acc_t{1} << (MachineConfig::bits + 1);
+
+            auto m = GcdWordMatrix{};
+            if (a < limit || b < limit) return m;
+
+            while (true) {
+                if (a >= b) {
+                    auto q = a / b;
+                    auto r = a - q * b;
+                    if (r < limit) {
+                        if (q == 1) break;
+                        --q;
+                        r += b;
+                        a = r;
+                        m.m01 += q * m.m00;
+                        m.m11 += q * m.m10;
+                        break;
+                    }
+                    a = r;
+                    m.m01 += q * m.m00;
+                    m.m11 += q * m.m10;
+                } else {
+                    auto q = b / a;
+                    auto r = b - q * a;
+                    if (r < limit) {
+                        if (q == 1) break;
+                        --q;
+                        r += a;
+                        b = r;
+                        m.m00 += q * m.m01;
+                        m.m10 += q * m.m11;
+                        break;
+                    }
+                    b = r;
+                    m.m00 += q * m.m01;
+                    m.m10 += q * m.m11;
+                }
+            }
+            return m;
+        }
+
+        /**
+         * (a; b) <- M^-1 * (a; b) in place.
+         * The results are non-negative and alpha <= a, beta <= b, so both fit their spans.
+        */
+        inline static constexpr auto gcd_apply_word(
+            std::span<Integer::value_type> a,
+            std::span<Integer::value_type> b,
+            GcdWordMatrix const& m
+        ) noexcept -> void {
+            using acc_t = MachineConfig::acc_t;
+            using iacc_t = MachineConfig::iacc_t;
+            using val_t = Integer::value_type;
+            constexpr auto bits = MachineConfig::bits;
+            constexpr auto mask = static_cast<iacc_t>(MachineConfig::mask);
+
+            auto const m00 = static_cast<iacc_t>(m.m00);
+            auto const m01 = static_cast<iacc_t>(m.m01);
+            auto const m10 = static_cast<iacc_t>(m.m10);
+            auto const m11 = static_cast<iacc_t>(m.m11);
+
+            auto const n = std::max(a.size(), b.size());
+            auto ca = iacc_t{};
+            auto cb = iacc_t{};
+            for (auto i = 0zu; i < n; ++i) {
+                auto const ai = i < a.size() ? static_cast<iacc_t>(a[i]) : iacc_t{};
+                auto const bi = i < b.size() ? static_cast<iacc_t>(b[i]) : iacc_t{};
+                auto const x = m11 * ai - m01 * bi + ca;
+                auto const y = m00 * bi - m10 * ai + cb;
+                if (i < a.size()) a[i] = static_cast<val_t>(static_cast<acc_t>(x & mask));
+                if (i < b.size()) b[i] = static_cast<val_t>(static_cast<acc_t>(y & mask));
+                ca = x >> bits;
+                cb = y >> bits;
+            }
+        }
+    } // namespace detail
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_GCD_LEHMER_HPP
@@ -45,7 +45,7 @@ namespace big_num::internal {
 
         constexpr auto set_neg(bool flag) noexcept -> void {
             auto f = static_cast<size_type>(flag) << last_bit_shift;
-            _bits |= f;
+            _bits = bits() | f;
         }
 
         constexpr auto is_neg() const noexcept -> bool {
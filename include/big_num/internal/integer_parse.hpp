@@ -9,112 +9,207 @@
 #include "number_span.hpp"
 #include "utils.hpp"
 #include "integer.hpp"
+#include "radix_powers.hpp"
+#include "swar.hpp"
+#include "div/schoolbook.hpp"
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cassert>
+#include <charconv>
 #include <climits>
+#include <cmath>
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <memory_resource>
 #include <expected>
+#include <iterator>
+#include <string>
 #include <string_view>
+#include <system_error>
 #include <type_traits>
 #include <vector>
 
 namespace big_num::internal {
     namespace detail {
+        /**
+         * Value of the n <= radix_chunk_digits(Radix) digits at p, checking each one.
+         * For decimals the last eight go through one SWAR word.
+        */
+        template <std::size_t Radix>
+        inline static constexpr auto parse_digit_chunk(
+            char const* p,
+            std::size_t n,
+            MachineConfig::uint_t& out
+        ) noexcept -> bool {
+            using acc_t = MachineConfig::acc_t;
+            auto tail = 0zu;
+            auto low = acc_t{};
+            if constexpr (Radix == 10) {
+                if (n >= 8) {
+                    tail = 8;
+                    auto const w = swar_load8(p + n - 8);
+                    if (!swar_is_decimal8(w)) return false;
+                    low = swar_decimal8(w);
+                }
+            }
+            auto acc = acc_t{};
+            for (auto i = 0zu; i < n - tail; ++i) {
+                auto const c = p[i];
+                auto const d = digit_mapping[static_cast<unsigned char>(c)];
+                if (d >= Radix || (d == 0 && c != '0')) return false;
+                acc = acc * Radix + d;
+            }
+            for (auto i = 0zu; i < tail; ++i) acc *= Radix;
+            out = static_cast<MachineConfig::uint_t>(acc + low);
+            return true;
+        }
+
+        /**
+         * out = value of the digits in `in`, most significant first; out has to be
+         * zeroed. The digits are taken radix_chunk_digits(Radix) at a time, nine
+         * for decimals, and every chunk is one multiply-add pass over the blocks
+         * so far, rather than a pass per digit.
+         * @returns false if a character is not a digit of the radix
+        */
         template <std::size_t Radix>
         inline static constexpr auto parse_integer_to_block_slow(
             std::span<MachineConfig::uint_t> out,
-            std::span<std::uint8_t> in
-        ) noexcept -> void {
-            auto out_size = std::size_t{};
-            using acc_t = typename Integer::acc_t;
-            for (auto i = 0zu; i < in.size(); ++i) {
-                auto c = static_cast<acc_t>(in[i]);
-                auto j = 0zu;
-                while (j <= out_size || c) {
-                    auto o = static_cast<acc_t>(out[j]);
-                    auto v = (o * Radix) + c;
-                    out[j++] = static_cast<MachineConfig::uint_t>(v & MachineConfig::mask);
-                    c = v >> MachineConfig::bits;
+            std::string_view in
+        ) noexcept -> bool {
+            using acc_t = MachineConfig::acc_t;
+            constexpr auto digits = radix_chunk_digits(Radix);
+            constexpr auto chunk = acc_t{radix_chunk(Radix)};
+
+            auto out_size = 0zu;
+            auto head = in.size() % digits;
+            if (head == 0) head = std::min(digits, in.size());
+            for (auto i = 0zu; i < in.size(); i += head, head = digits) {
+                auto v = MachineConfig::uint_t{};
+                if (!parse_digit_chunk<Radix>(in.data() + i, head, v)) return false;
+                auto c = acc_t{v};
+                for (auto j = 0zu; j < out_size; ++j) {
+                    auto const t = acc_t{out[j]} * chunk + c;
+                    out[j] = static_cast<MachineConfig::uint_t>(t & MachineConfig::mask);
+                    c = t >> MachineConfig::bits;
+                }
+                while (c) {
+                    out[out_size++] = static_cast<MachineConfig::uint_t>(c & MachineConfig::mask);
+                    c >>= MachineConfig::bits;
                 }
-
-                out_size = std::max(out_size, j);
             }
+            return true;
         }
 
+        /**
+         * Digits of a power-of-two radix are bit fields of the value: eight at a
+         * time are packed by `swar_pack8` from the end of the text into a bit
+         * window that is flushed a block at a time.
+         * @returns false if a character is not a digit of the radix
+        */
         template <std::size_t Radix>
             requires ((Radix & (Radix - 1)) == 0)
         inline static constexpr auto parse_integer_to_block(
             num_t& out,
-            std::span<std::uint8_t> in,
+            std::string_view in,
             [[maybe_unused]] std::pmr::memory_resource* resource
-        ) noexcept -> void {
+        ) noexcept -> bool {
+            using acc_t = MachineConfig::acc_t;
             using val_t = num_t::value_type;
-            auto c = val_t{};
-
-            constexpr auto pos = static_cast<val_t>(std::bit_width(Radix) - 1);
+            constexpr auto pos = static_cast<std::size_t>(std::bit_width(Radix) - 1);
 
-            auto k = 0zu;
+            auto c = acc_t{};
             auto l = 0zu;
-
-            for (auto i = in.size(); i > 0; --i) {
-                auto v = static_cast<val_t>(in[i - 1]);
+            auto k = 0zu;
+            auto push = [&](acc_t v, std::size_t bits) {
                 c |= v << l;
-                l += pos;
-                if (l >= MachineConfig::bits) {
-                    out[k++] = c & MachineConfig::mask;
+                l += bits;
+                while (l >= MachineConfig::bits) {
+                    out[k++] = static_cast<val_t>(c & MachineConfig::mask);
+                    c >>= MachineConfig::bits;
                     l -= MachineConfig::bits;
-                    c = v >> (pos - l);
                 }
+            };
+
+            auto i = in.size();
+            for (; i >= 8; i -= 8) {
+                auto v = std::uint64_t{};
+                if (!swar_pack8<Radix>(swar_load8(in.data() + i - 8), v)) return false;
+                push(v, 8 * pos);
+            }
+            for (; i > 0; --i) {
+                auto const ch = in[i - 1];
+                auto const d = digit_mapping[static_cast<unsigned char>(ch)];
+                if (d >= Radix || (d == 0 && ch != '0')) return false;
+                push(d, pos);
             }
-            if (c) out[k++] = c;
+            if (c) out[k++] = static_cast<val_t>(c);
+            return true;
         }
 
+        /**
+         * Splits the digits as in = l * R^(d 2^k) + r with the largest power that
+         * leaves at least half of the digits to l, so the product of the left half
+         * with a power from the shared cache puts it in place; no power is
+         * recomputed at any level.
+        */
         template <std::size_t Radix>
-            requires ((Radix & (Radix - 1)) != 0)
-        inline static constexpr auto parse_integer_to_block(
+        inline static auto parse_integer_to_block_rec(
             num_t& out,
-            std::span<std::uint8_t> in,
-            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
-        ) noexcept -> void {
-            auto const size = in.size();
+            std::string_view in,
+            RadixPowerTable<Radix>& table,
+            std::pmr::memory_resource* resource
+        ) -> bool {
             using val_t = num_t::value_type;
-            if (size <= MachineConfig::parse_naive_threshold) {
-                parse_integer_to_block_slow<Radix>(out, in);
-                return;
+            if (in.size() <= MachineConfig::parse_naive_threshold) {
+                return parse_integer_to_block_slow<Radix>(out, in);
             }
 
-            auto const mid = size >> 1;
-
-            auto lhs = std::span(in.data(), mid);
-            auto rhs = std::span(in.data() + mid, in.size() - mid);
-
-            auto nl = std::pmr::vector<val_t>{lhs.size(), 0, resource};
-            auto nr = std::pmr::vector<val_t>{rhs.size(), 0, resource};
-
-            auto snl = NumberSpan(std::span(nl));
-            auto snr = NumberSpan(std::span(nr));
+            auto const& e = table[table.split_index_digits(in.size())];
+            auto const mid = in.size() - e.digits();
+            auto lhs = in.substr(0, mid);
+            auto rhs = in.substr(mid);
+
+            auto tmp = std::pmr::vector<val_t>(radix_digits_blocks(Radix, lhs.size()), 0, resource);
+            auto st = NumberSpan(std::span(tmp));
+            if (!parse_integer_to_block_rec<Radix>(st, lhs, table, resource)) return false;
+
+            auto const l = const_num_t(tmp.data(), tmp.size()).trim_trailing_zeros();
+            if (!l.empty()) {
+                auto const p = e.power();
+                mul_unbalanced(
+                    num_t(out.data(), l.size() + p.size()),
+                    l,
+                    const_num_t(p.data(), p.size()),
+                    resource
+                );
+            }
 
-            parse_integer_to_block<Radix>(snl, lhs, resource);
-            parse_integer_to_block<Radix>(snr, rhs, resource);
+            tmp.assign(radix_digits_blocks(Radix, rhs.size()), 0);
+            st = NumberSpan(std::span(tmp));
+            if (!parse_integer_to_block_rec<Radix>(st, rhs, table, resource)) return false;
+            abs_add(out, st);
+            return true;
+        }
 
-            constexpr auto bits = static_cast<std::size_t>(std::bit_width(Radix));
-            if constexpr ((Radix & (Radix - 1)) == 0) {
-                snl = NumberSpan(nl.data(), nl.size());
-                std::copy(snl.begin(), snl.end(), out.begin());
-                shift_left(out, (bits - 1) * rhs.size());
-            } else {
-                auto const blocks = MachineConfig::size(bits) * rhs.size() * 2;
-                std::pmr::vector<val_t> base(blocks, resource);
-                base[0] = Radix;
-                auto sb = NumberSpan(std::span(base));
-                pow(sb, { base.data(), 1 }, rhs.size());
-                sb = sb.trim_trailing_zeros();
-                mul(out, snl, sb);
+        /**
+         * Reads the characters of `in` straight into out, which has to be zeroed
+         * and hold `radix_digits_blocks(Radix, in.size())` blocks.
+         * @returns false if a character is not a digit of the radix
+        */
+        template <std::size_t Radix>
+            requires ((Radix & (Radix - 1)) != 0)
+        inline static constexpr auto parse_integer_to_block(
+            num_t& out,
+            std::string_view in,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        ) noexcept -> bool {
+            if (in.size() <= MachineConfig::parse_naive_threshold) {
+                return parse_integer_to_block_slow<Radix>(out, in);
             }
-            abs_add(out, snr);
+            auto table = RadixPowerTable<Radix>(resource);
+            return parse_integer_to_block_rec<Radix>(out, in, table, resource);
         }
 
         inline static constexpr auto normalize_string(std::string_view num, std::string& buf) -> std::string_view {
@@ -138,6 +233,29 @@ namespace big_num::internal {
 
             return buf;
         }
+
+        // Digits go from the text straight into blocks and are checked on the way.
+        template <std::size_t Radix>
+        inline static constexpr auto parse_radix(
+            Integer& out,
+            std::string_view text,
+            std::string_view error,
+            std::pmr::memory_resource* resource
+        ) -> std::expected<void, std::string_view> {
+            out.resize(radix_digits_blocks(Radix, text.size()) * MachineConfig::bits);
+            out.fill(0);
+
+            auto o = out.to_span();
+            if (!parse_integer_to_block<Radix>(o, text, resource)) {
+                out.resize(0);
+                out.set_neg(false);
+                return std::unexpected(error);
+            }
+            out.remove_trailing_empty_blocks();
+            // "-000" is zero, which has no sign
+            if (out.empty()) out.set_neg(false);
+            return {};
+        }
     } // namespace detail
 
     inline static constexpr auto parse_integer(
@@ -168,100 +286,42 @@ namespace big_num::internal {
             default: break;
         }
 
-        auto sz = text.size();
-        std::pmr::vector<std::uint8_t> tmp(resource);
-
         if (text[0] == '0') {
-            if (text.size() < 2) return {};
+            if (text.size() < 2) {
+                out.set_neg(false);
+                return {};
+            }
 
             switch (text[1]) {
                 case 'x': case 'X': {
                     if (text.size() < 3) return std::unexpected("Missing number after radix prefix: '0x'");
                     if (radix_hint == 0) radix_hint = 16;
                     if (radix_hint != 16) return std::unexpected("Radix mismatch: expected radix to be base-16");
-                    text = text.substr(2);
-                    if (!validate_hex(text)) return std::unexpected("Invalid hexadecimal number");
-
-                    sz = text.size();
-                    tmp.resize(sz, 0);
-                    for (auto i = 0zu; i < sz; ++i) {
-                        auto c = text[i];
-                        tmp[i] = digit_mapping[static_cast<std::size_t>(c)];
-                    }
-                } break;
+                    return detail::parse_radix<16>(out, text.substr(2), "Invalid hexadecimal number", resource);
+                }
                 case 'b': case 'B': {
                     if (text.size() < 3) return std::unexpected("Missing number after radix prefix: '0b'");
                     if (radix_hint == 0) radix_hint = 2;
                     if (radix_hint != 2) return std::unexpected("Radix mismatch: expected radix to be base-2");
-                    text = text.substr(2);
-                    if (!validate_binary(text)) return std::unexpected("Invalid binary number");
-
-                    sz = text.size();
-                    tmp.resize(sz, 0);
-                    for (auto i = 0zu; i < sz; ++i) {
-                        auto c = text[i];
-                        tmp[i] = digit_mapping[static_cast<std::size_t>(c)];
-                    }
-                } break;
+                    return detail::parse_radix<2>(out, text.substr(2), "Invalid binary number", resource);
+                }
                 case 'o': case 'O': {
                     if (text.size() < 3) return std::unexpected("Missing number after radix prefix: '0o'");
                     if (radix_hint == 0) radix_hint = 8;
                     if (radix_hint != 8) return std::unexpected("Radix mismatch: expected radix to be base-8");
-                    text = text.substr(2);
-                    if (!validate_octal(text)) return std::unexpected("Invalid octal number");
-
-                    sz = text.size();
-                    tmp.resize(sz, 0);
-                    for (auto i = 0zu; i < sz; ++i) {
-                        auto c = text[i];
-                        tmp[i] = digit_mapping[static_cast<std::size_t>(c)];
-                    }
-                } break;
+                    return detail::parse_radix<8>(out, text.substr(2), "Invalid octal number", resource);
+                }
                 default: {
                     if (radix_hint == 0) radix_hint = 10;
                     if (radix_hint != 10) return std::unexpected("Radix mismatch: expected radix to be base-10");
-                    if (!validate_decimal(text)) return std::unexpected("Invalid decimal number");
-
-                    sz = text.size();
-                    tmp.resize(sz, 0);
-                    for (auto i = 0zu; i < sz; ++i) {
-                        auto c = text[i];
-                        tmp[i] = digit_mapping[static_cast<std::size_t>(c)];
-                    }
+                    return detail::parse_radix<10>(out, text, "Invalid decimal number", resource);
                 }
             }
-        } else {
-            if (radix_hint == 0) radix_hint = 10;
-            if (radix_hint != 10) return std::unexpected("Radix mismatch: expected radix to be base-10");
-
-            tmp.resize(sz, 0);
-            for (auto i = 0zu; i < sz; ++i) {
-                auto c = text[i];
-                tmp[i] = digit_mapping[static_cast<std::size_t>(c)];
-            }
-        }
-
-        out.resize(tmp.size() * MachineConfig::bits);
-        out.fill(0);
-
-        auto o = out.to_span();
-        switch (radix_hint) {
-            case 2: {
-                detail::parse_integer_to_block<2>(o, tmp, resource);
-            } break;
-            case 8: {
-                detail::parse_integer_to_block<8>(o, tmp, resource);
-            } break;
-            case 10: {
-                detail::parse_integer_to_block<10>(o, tmp, resource);
-            } break;
-            case 16: {
-                detail::parse_integer_to_block<16>(o, tmp, resource);
-            } break;
         }
 
-        out.remove_trailing_empty_blocks();
-        return {};
+        if (radix_hint == 0) radix_hint = 10;
+        if (radix_hint != 10) return std::unexpected("Radix mismatch: expected radix to be base-10");
+        return detail::parse_radix<10>(out, text, "Invalid decimal number", resource);
     }
 
     template <std::integral T>
@@ -303,111 +363,359 @@ namespace big_num::internal {
         out.remove_trailing_empty_blocks();
     }
 
+    struct IntegerStringConvConfig {
+        bool show_prefix            { false };
+        bool show_separator         { false };
+        std::string_view separator  { "_" };
+        std::size_t group_size      { 0 /* auto select group size */ };
+    };
+
     namespace detail {
+        /**
+         * Hands digits, most significant first, to a sink and puts the separator
+         * in front of every group of `group` digits counted from the end, so the
+         * total digit count has to be known up front. Digits of one group go
+         * out in one piece.
+        */
+        template <typename Sink>
+        struct DigitWriter {
+            Sink& sink;
+            std::size_t total;
+            std::size_t group; // 0 -> no separators
+            std::string_view separator;
+            std::size_t remaining{total};
+
+            auto write(std::string_view digits) -> void {
+                assert(digits.size() <= remaining);
+                if (group == 0) {
+                    sink(digits);
+                    remaining -= digits.size();
+                    return;
+                }
+                while (!digits.empty()) {
+                    auto const r = remaining % group;
+                    if (r == 0 && remaining != total) sink(separator);
+                    auto const n = std::min(r == 0 ? group : r, digits.size());
+                    sink(digits.substr(0, n));
+                    remaining -= n;
+                    digits.remove_prefix(n);
+                }
+            }
+
+            auto write_zeros(std::size_t n) -> void {
+                static constexpr auto zeros = std::string_view("0000000000000000000000000000000000000000000000000000000000000000");
+                while (n > 0) {
+                    auto const k = std::min(n, zeros.size());
+                    write(zeros.substr(0, k));
+                    n -= k;
+                }
+            }
+        };
+
+        // Digits of a trimmed `in` in a power-of-two radix.
+        template <std::size_t To>
+            requires ((To & (To - 1)) == 0)
+        inline static constexpr auto pow2_digit_count(std::span<MachineConfig::uint_t const> in) noexcept -> std::size_t {
+            constexpr auto pos = static_cast<std::size_t>(std::bit_width(To) - 1);
+            return (vec_bits(in) + pos - 1) / pos;
+        }
+
+        /**
+         * Digits of a trimmed `in`. The logarithm of the top blocks settles it
+         * unless the value sits next to a power of the radix; only then is the
+         * power built and compared against.
+        */
         template <std::size_t To>
-            requires (To <= 16)
-        inline static constexpr auto convert_to_string_slow(
+        inline static auto radix_digit_count(
             std::span<MachineConfig::uint_t const> in,
-            std::span<char> out
-        ) noexcept -> void {
-            using acc_t = MachineConfig::acc_t;
-            auto out_size = std::size_t{};
-            auto in_size = in.size();
-            for (auto i = 0zu; i < in_size; ++i) {
-                auto c = static_cast<acc_t>(in[in_size - i - 1]);
-                auto j = 0zu;
-                while (j <= out_size || c) {
-                    auto o = static_cast<acc_t>(out[j]);
-                    auto v = (o << MachineConfig::bits) + c;
-                    out[j++] = static_cast<char>(v % To);
-                    c = v / To;
+            RadixPowerTable<To>& table,
+            std::pmr::memory_resource* resource
+        ) -> std::size_t {
+            if (in.empty()) return 0;
+            if constexpr ((To & (To - 1)) == 0) {
+                return pow2_digit_count<To>(in);
+            } else {
+                auto const n = std::min(in.size(), 3zu);
+                auto top = 0.0;
+                for (auto i = 1zu; i <= n; ++i) {
+                    top = top * static_cast<double>(MachineConfig::max) + static_cast<double>(in[in.size() - i]);
                 }
-                out_size = std::max(out_size, j);
+                auto const shift = static_cast<double>((in.size() - n) * MachineConfig::bits);
+                auto const l = (std::log2(top) + shift) / std::log2(static_cast<double>(To));
+                auto const f = std::floor(l);
+                auto const tol = 1e-9 + l * 1e-14;
+                if (l - f > tol && f + 1 - l > tol) return static_cast<std::size_t>(f) + 1;
+
+                auto const m = static_cast<std::size_t>(std::round(l));
+                auto buf = block_vec_t(resource);
+                auto const p = table.power_of(buf, m);
+                return std::is_lt(vec_compare(in, p)) ? m : m + 1;
             }
         }
 
-        template <std::size_t To>
+        /**
+         * Digits of a trimmed `in` in a power-of-two radix, most significant first.
+         * Every eight digits are one bit field of the value, which `swar_unpack8`
+         * spreads into ASCII in a single step.
+        */
+        template <std::size_t To, typename Writer>
             requires ((To & (To - 1)) == 0)
-        inline static constexpr auto convert_to_string(
+        inline static auto write_pow2_digits(
             std::span<MachineConfig::uint_t const> in,
-            std::span<char> out,
-            [[maybe_unused]] std::pmr::memory_resource* resource
-        ) noexcept -> void {
+            Writer& w
+        ) -> void {
+            constexpr auto pos = static_cast<std::size_t>(std::bit_width(To) - 1);
+            // n <= 32 bits starting at bit p
+            auto bits_at = [in](std::size_t p, std::size_t n) {
+                auto const o = p % MachineConfig::bits;
+                auto v = std::uint64_t{};
+                for (auto i = p / MachineConfig::bits, l = 0zu; l < o + n && i < in.size(); ++i, l += MachineConfig::bits) {
+                    v |= std::uint64_t{in[i]} << l;
+                }
+                return (v >> o) & ((std::uint64_t{1} << n) - 1);
+            };
+
+            auto buf = std::array<char, 256>{};
             auto k = 0zu;
-            auto c = MachineConfig::uint_t{};
-
-            auto bits = 0zu;
-            constexpr auto required_bits = static_cast<std::size_t>(std::bit_width(To) - 1);
-            for (auto i = 0zu; i < in.size(); ++i) {
-                for (auto j = 0zu; j < MachineConfig::bits; ++j) {
-                    if constexpr (To == 2) {
-                        out[k++] |= (in[i] >> j) & 1;
-                    } else {
-                        c |= ((in[i] >> j) & 1) << bits;
-                        ++bits;
-                        if (bits == required_bits) {
-                            out[k++] = static_cast<char>(c);
-                            c = 0;
-                            bits = 0;
-                        }
-                    }
+            auto i = pow2_digit_count<To>(in);
+            for (; i % 8 != 0; --i) {
+                buf[k++] = digit_to_char_mapping[static_cast<std::size_t>(bits_at((i - 1) * pos, pos))];
+            }
+            for (; i > 0; i -= 8) {
+                if (k + 8 > buf.size()) {
+                    w.write(std::string_view(buf.data(), k));
+                    k = 0;
                 }
+                swar_store8(buf.data() + k, swar_unpack8<To>(bits_at((i - 8) * pos, 8 * pos)));
+                k += 8;
             }
+            w.write(std::string_view(buf.data(), k));
+        }
 
-            if (bits) {
-                out[k++] = static_cast<char>(c);
+        /**
+         * Writes `in` as exactly `width` digits, zero padded; in < To^width.
+         * One single-block division by To^d yields the next d digits, so the
+         * quadratic loop runs d times fewer steps than dividing out one digit
+         * at a time.
+        */
+        template <std::size_t To, typename Writer>
+        inline static auto write_digits_basecase(
+            std::span<MachineConfig::uint_t const> in,
+            std::size_t width,
+            Writer& w,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            constexpr auto chunk = radix_chunk(To);
+            constexpr auto digits = radix_chunk_digits(To);
+            auto tmp = std::pmr::vector<MachineConfig::uint_t>(in.begin(), in.end(), resource);
+            auto buf = std::pmr::vector<char>(in.size() * MachineConfig::bits / static_cast<std::size_t>(std::bit_width(To) - 1) + digits, resource);
+            auto len = tmp.size();
+            auto k = buf.size();
+            while (len > 0) {
+                auto const t = std::span(tmp.data(), len);
+                auto r = schoolbook_div_1(t, t, chunk);
+                while (len > 0 && tmp[len - 1] == 0) --len;
+                for (auto j = 0zu; j < digits; ++j) {
+                    buf[--k] = digit_to_char_mapping[static_cast<std::size_t>(r % To)];
+                    r /= To;
+                }
             }
+            while (k < buf.size() && buf[k] == '0') ++k;
+
+            auto const n = buf.size() - k;
+            assert(n <= width);
+            w.write_zeros(width - n);
+            w.write(std::string_view(buf.data() + k, n));
         }
 
-        template <std::size_t To>
-            requires ((To & (To - 1)) != 0)
-        inline static constexpr auto convert_to_string(
+        /**
+         * Splits in = q * R^(d 2^k) + r with the largest power no longer than half
+         * of `in`, so r owns exactly d 2^k digits and q the rest; q goes out
+         * first, which keeps the digits in order. The divisions go through the
+         * prepared divisors of the shared power cache, which use the fast `mul`
+         * tiers once they are large and are only built once per process.
+        */
+        template <std::size_t To, typename Writer>
+        inline static auto write_digits_rec(
             std::span<MachineConfig::uint_t const> in,
-            std::span<char> out,
-            [[maybe_unused]] std::pmr::memory_resource* resource
-        ) noexcept -> void {
-            // auto const size = in.size();
-            // if (size <= 2) {
-                convert_to_string_slow<To>(in, out);
+            std::size_t width,
+            Writer& w,
+            RadixPowerTable<To>& table,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            using val_t = MachineConfig::uint_t;
+            if (in.size() <= MachineConfig::to_string_naive_threshold) {
+                write_digits_basecase<To>(in, width, w, resource);
                 return;
-            // }
-
-            // auto const mid = size >> 1;
-            //
-            // auto lhs = std::span(in.data(), mid);
-            // auto rhs = std::span(in.data() + mid, in.size() - mid);
-            //
-            // constexpr auto bits = static_cast<std::size_t>(std::bit_width(To));
-            //
-            // auto nl = std::pmr::vector<char>{lhs.size() * (MachineConfig::bits / bits) * 2, 0, resource};
-            // auto nr = std::pmr::vector<char>{rhs.size() * (MachineConfig::bits / bits) * 2, 0, resource};
-            //
-            // convert_to_string<To>(lhs, nl, resource);
-            // convert_to_string<To>(rhs, nr, resource);
-
-            // std::copy(nl.begin(), nl.end(), out.begin() + static_cast<std::ptrdiff_t>(rhs.size()));
-            // auto c = std::size_t{};
-            // auto i = 0zu;
-            // for (; i < rhs.size(); ++i) {
-            //     auto s = static_cast<std::size_t>(out[i]) + static_cast<std::size_t>(nr[i]) + c;
-            //     out[i] = static_cast<char>(s % To);
-            //     c = s / To;
-            // }
-            //
-            // while (i < out.size() && c) {
-            //     auto s = static_cast<std::size_t>(out[i]) + c;
-            //     out[i++] = static_cast<char>(s % To);
-            //     c = s / To;
-            // }
+            }
+
+            auto const& e = table[table.split_index_blocks(in.size())];
+            auto const& den = e.divisor();
+
+            auto q = std::pmr::vector<val_t>(den.quotient_size(in.size()), 0, resource);
+            auto r = std::pmr::vector<val_t>(den.size(), 0, resource);
+            {
+                auto scratch = std::pmr::vector<val_t>(den.scratch_size(in.size()), 0, resource);
+                den.divmod(
+                    num_t(q.data(), q.size()),
+                    num_t(r.data(), r.size()),
+                    const_num_t(in.data(), in.size()),
+                    std::span(scratch),
+                    resource
+                );
+            }
+            auto const qs = const_num_t(q.data(), q.size()).trim_trailing_zeros().span();
+            auto const rs = const_num_t(r.data(), r.size()).trim_trailing_zeros().span();
+            write_digits_rec<To>(qs, width - e.digits(), w, table, resource);
+            write_digits_rec<To>(rs, e.digits(), w, table, resource);
+        }
+
+        /**
+         * Everything about printing one number that is known before the first
+         * digit: sign, prefix, the exact digit count and so the exact length.
+        */
+        template <std::size_t To>
+        struct IntegerFormatter {
+            IntegerFormatter(
+                const_num_t const& in,
+                IntegerStringConvConfig const& config,
+                std::pmr::memory_resource* resource
+            )
+                : m_in(in.trim_trailing_zeros().span())
+                , m_neg(in.is_neg() && !m_in.empty())
+                , m_table(resource)
+                , m_resource(resource)
+            {
+                m_digits = std::max(radix_digit_count<To>(m_in, m_table, resource), 1zu);
+                if (config.show_prefix) {
+                    switch (To) {
+                        case  2: m_prefix = "0b"; break;
+                        case  8: m_prefix = "0o"; break;
+                        case 16: m_prefix = "0x"; break;
+                        default: break;
+                    }
+                }
+                if (config.show_separator) {
+                    m_group = config.group_size;
+                    if (m_group == 0) {
+                        switch (To) {
+                            case  2: m_group = 8; break;
+                            case 16: m_group = 4; break;
+                            default: m_group = 3; break;
+                        }
+                    }
+                    m_separator = config.separator;
+                }
+            }
+
+            auto size() const noexcept -> std::size_t {
+                auto const groups = m_group == 0 ? 0zu : (m_digits - 1) / m_group;
+                return static_cast<std::size_t>(m_neg) + m_prefix.size() + m_digits + groups * m_separator.size();
+            }
+
+            // Hands out the characters in order as string_views; there are `size()` of them.
+            template <typename Sink>
+            auto write(Sink& sink) -> void {
+                if (m_neg) sink(std::string_view("-"));
+                if (!m_prefix.empty()) sink(m_prefix);
+
+                auto w = DigitWriter<Sink>{ sink, m_digits, m_group, m_separator };
+                if (m_in.empty()) {
+                    w.write("0");
+                } else if constexpr ((To & (To - 1)) == 0) {
+                    write_pow2_digits<To>(m_in, w);
+                } else {
+                    write_digits_rec<To>(m_in, m_digits, w, m_table, m_resource);
+                }
+            }
+
+        private:
+            std::span<MachineConfig::uint_t const> m_in;
+            bool m_neg;
+            RadixPowerTable<To> m_table;
+            std::pmr::memory_resource* m_resource;
+            std::size_t m_digits;
+            std::string_view m_prefix{};
+            std::size_t m_group{};
+            std::string_view m_separator{};
+        };
+
+        template <typename Fn>
+        inline static auto visit_radix(std::uint8_t radix, Fn&& fn) -> decltype(auto) {
+            assert((radix == 2 || radix == 8 || radix == 10 || radix == 16) && "radix must be one of 2, 8, 10, or 16");
+            switch (radix) {
+                case  2: return fn(std::integral_constant<std::size_t, 2>{});
+                case  8: return fn(std::integral_constant<std::size_t, 8>{});
+                case 16: return fn(std::integral_constant<std::size_t, 16>{});
+                default: return fn(std::integral_constant<std::size_t, 10>{});
+            }
         }
     } // namespace detail
 
-    struct IntegerStringConvConfig {
-        bool show_prefix            { false };
-        bool show_separator         { false };
-        std::string_view separator  { "_" };
-        std::size_t group_size      { 0 /* auto select group size */ };
-    };
+    // Exact number of characters `to_chars` writes for `in`.
+    inline static auto chars_length(
+        const_num_t const& in,
+        std::uint8_t radix = 10,
+        IntegerStringConvConfig config = {},
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> std::size_t {
+        return detail::visit_radix(radix, [&](auto to) {
+            return detail::IntegerFormatter<decltype(to)::value>(in, config, resource).size();
+        });
+    }
+
+    /**
+     * Hands the text of `in` to `sink` as string_views, in order, without
+     * building it anywhere; the pieces are only valid during the call.
+    */
+    template <typename Sink>
+        requires std::invocable<Sink&, std::string_view>
+    inline static auto write_integer(
+        Sink&& sink,
+        const_num_t const& in,
+        std::uint8_t radix = 10,
+        IntegerStringConvConfig config = {},
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        detail::visit_radix(radix, [&](auto to) {
+            auto f = detail::IntegerFormatter<decltype(to)::value>(in, config, resource);
+            f.write(sink);
+        });
+    }
+
+    /**
+     * Writes the text of `in` to [first, last) like `std::to_chars`.
+     * @returns {last, std::errc::value_too_large} and leaves the range
+     *          untouched if the text does not fit
+    */
+    inline static auto to_chars(
+        char* first,
+        char* last,
+        const_num_t const& in,
+        std::uint8_t radix = 10,
+        IntegerStringConvConfig config = {},
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> std::to_chars_result {
+        return detail::visit_radix(radix, [&](auto to) -> std::to_chars_result {
+            auto f = detail::IntegerFormatter<decltype(to)::value>(in, config, resource);
+            if (f.size() > static_cast<std::size_t>(last - first)) return { last, std::errc::value_too_large };
+            auto sink = [&first](std::string_view s) { first = std::copy(s.begin(), s.end(), first); };
+            f.write(sink);
+            return { first, std::errc{} };
+        });
+    }
+
+    template <std::output_iterator<char> It>
+    inline static auto to_chars(
+        It out,
+        const_num_t const& in,
+        std::uint8_t radix = 10,
+        IntegerStringConvConfig config = {},
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> It {
+        write_integer([&out](std::string_view s) { out = std::copy(s.begin(), s.end(), out); }, in, radix, config, resource);
+        return out;
+    }
 
     // if radix is 0, we print the underlying representation.
     inline static auto to_string(
@@ -418,22 +726,11 @@ namespace big_num::internal {
     ) -> std::string {
         std::string res;
 
-        if (in.empty()) { 
-            switch (radix) {
-                case  2: res += "0b"; break;
-                case  8: res += "0o"; break;
-                case 10: break;
-                case 16: res += "0x"; break;
-                default: break;
-            }
-            res += '0';
-            return res;
-        }
-
         auto size = in.size();
         auto data = in.data();
 
         if (radix == 0) {
+            if (in.empty()) return "0";
             res.reserve(size);
             for (auto i = 0zu; i < size; ++i) {
                 res += std::to_string(data[size - i - 1]);
@@ -444,59 +741,13 @@ namespace big_num::internal {
             return res; 
         }
 
-        assert((radix == 2 || radix == 8 || radix == 10 || radix == 16) && "radix must be one of 2, 8, 10, or 16");
-
-        auto const total_bits = size * MachineConfig::bits;
-
-        std::size_t prefix_offset = 2zu * static_cast<std::size_t>(config.show_prefix) * static_cast<std::size_t>(radix != 10) + static_cast<std::size_t>(in.is_neg());
-        res.resize(total_bits + prefix_offset, 0);
-        auto res_ptr = res.data() + prefix_offset;
-        auto res_size = res.size() - prefix_offset;
-        auto res_span = std::span(res_ptr, res_size);
-        auto start_index = 0zu;
-        if (in.is_neg()) {
-            start_index = 1;
-            res[0] = '-';
-        }
-        switch (radix) {
-            case 2: {
-                if (config.group_size == 0) config.group_size = 8;
-                if (config.show_prefix) { res[start_index] = '0'; res[start_index + 1] = 'b'; }
-                detail::convert_to_string<2>(in, res_span, resource);
-            } break;
-            case 8: {
-                if (config.group_size == 0) config.group_size = 3;
-                if (config.show_prefix) { res[start_index] = '0'; res[start_index + 1] = 'o'; }
-                detail::convert_to_string<8>(in, res_span, resource);
-            } break;
-            case 10: {
-                if (config.group_size == 0) config.group_size = 3;
-                detail::convert_to_string<10>(in, res_span, resource);
-            } break;
-            case 16: {
-                if (config.group_size == 0) config.group_size = 4;
-                if (config.show_prefix) { res[start_index] = '0'; res[start_index + 1] = 'x'; }
-                detail::convert_to_string<16>(in, res_span, resource);
-            } break;
-            default: break;
-        }
-
-        auto res_start = res.begin() + static_cast<int>(prefix_offset);
-        std::reverse(res_start, res.end());
-        for (auto& c: res_span) {
-            c = digit_to_char_mapping[static_cast<std::size_t>(c)];
-        }
-        auto it = std::find_if_not(res_start, res.end(), [](char c) { return c == '0'; });
-        res.erase(res_start, it);
-
-        if (config.show_separator) {
-            auto sz = static_cast<std::ptrdiff_t>(std::max(res.size(), config.group_size - 1) - config.group_size + 1);
-            for (auto i = sz - 1; i > static_cast<int>(prefix_offset); i -= config.group_size) {
-                auto pos = static_cast<std::size_t>(i);
-                res.insert(pos, config.separator);
-            }
-        }
-
+        detail::visit_radix(radix, [&](auto to) {
+            auto f = detail::IntegerFormatter<decltype(to)::value>(in, config, resource);
+            res.resize(f.size());
+            auto p = res.data();
+            auto sink = [&p](std::string_view s) { p = std::copy(s.begin(), s.end(), p); };
+            f.write(sink);
+        });
         return res;
     }
 } // big_num::internal
@@ -0,0 +1,356 @@
+#ifndef AMT_BIG_NUM_INTERNAL_INTEGER_STREAM_HPP
+#define AMT_BIG_NUM_INTERNAL_INTEGER_STREAM_HPP
+
+#include "integer.hpp"
+#include "base.hpp"
+#include "block_vec.hpp"
+#include "integer_parse.hpp"
+#include "radix_powers.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <expected>
+#include <istream>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if __has_include(<unistd.h>)
+#include <cerrno>
+#include <unistd.h>
+#define BIG_NUM_HAS_FD_SOURCE
+#endif
+
+namespace big_num::internal {
+    /**
+     * Input for `parse_integer_stream`: next() hands out the text a chunk at a
+     * time and an empty chunk at the end. A chunk only has to stay valid until
+     * the following call.
+    */
+    template <typename S>
+    concept CharSource = requires(S& s) {
+        { s.next() } -> std::same_as<std::expected<std::string_view, std::string_view>>;
+    };
+
+    // Text that is already in memory, such as a mapped file; nothing is copied.
+    struct MemorySource {
+        explicit MemorySource(std::string_view text) noexcept
+            : m_text(text)
+        {}
+
+        auto next() noexcept -> std::expected<std::string_view, std::string_view> {
+            return std::exchange(m_text, std::string_view{});
+        }
+
+    private:
+        std::string_view m_text;
+    };
+
+    struct IstreamSource {
+        explicit IstreamSource(
+            std::istream& in,
+            std::size_t chunk = 1zu << 16,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        )
+            : m_in(in)
+            , m_buf(chunk, resource)
+        {}
+
+        auto next() -> std::expected<std::string_view, std::string_view> {
+            m_in.read(m_buf.data(), static_cast<std::streamsize>(m_buf.size()));
+            auto const n = static_cast<std::size_t>(m_in.gcount());
+            if (n == 0 && m_in.bad()) return std::unexpected("Read error");
+            return std::string_view(m_buf.data(), n);
+        }
+
+    private:
+        std::istream& m_in;
+        std::pmr::vector<char> m_buf;
+    };
+
+    #ifdef BIG_NUM_HAS_FD_SOURCE
+    // Reads a file descriptor, a pipe or a socket; the descriptor is not closed.
+    struct FdSource {
+        explicit FdSource(
+            int fd,
+            std::size_t chunk = 1zu << 16,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        )
+            : m_fd(fd)
+            , m_buf(chunk, resource)
+        {}
+
+        auto next() -> std::expected<std::string_view, std::string_view> {
+            while (true) {
+                auto const n = ::read(m_fd, m_buf.data(), m_buf.size());
+                if (n >= 0) return std::string_view(m_buf.data(), static_cast<std::size_t>(n));
+                if (errno != EINTR) return std::unexpected("Read error");
+            }
+        }
+
+    private:
+        int m_fd;
+        std::pmr::vector<char> m_buf;
+    };
+    #endif
+
+    namespace detail {
+        /**
+         * Builds an integer from digits that arrive in order, holding at most one
+         * piece of text. Each full piece of `piece_digits` digits is parsed and
+         * pushed on a stack that merges like a binary counter: two values of
+         * the same level l become left * R^(piece_digits 2^l) + right, so every
+         * merge is a balanced product with a power from the shared cache. The
+         * values on the stack together are no larger than the result.
+        */
+        template <std::size_t Radix>
+        struct StreamParser {
+            using value_type = Integer::value_type;
+            static constexpr auto is_pow2 = (Radix & (Radix - 1)) == 0;
+            static constexpr auto chunk_digits = radix_chunk_digits(Radix);
+            // radix_chunk_digits(Radix) 2^k, the largest that the basecase still takes
+            static constexpr auto piece_digits = [] {
+                auto n = chunk_digits;
+                while (2 * n <= MachineConfig::parse_naive_threshold) n *= 2;
+                return n;
+            }();
+
+            StreamParser(std::pmr::memory_resource* resource)
+                : m_table(resource)
+                , m_stack(resource)
+                , m_piece(resource)
+                , m_tmp(resource)
+                , m_resource(resource)
+            {
+                m_piece.reserve(piece_digits);
+            }
+
+            auto digits() const noexcept -> std::size_t { return m_digits; }
+
+            // @returns false if a character is not a digit of the radix
+            auto push(std::string_view text) -> bool {
+                m_digits += text.size();
+                while (!text.empty()) {
+                    auto const n = std::min(text.size(), piece_digits - m_piece.size());
+                    m_piece.insert(m_piece.end(), text.begin(), text.begin() + static_cast<std::ptrdiff_t>(n));
+                    text.remove_prefix(n);
+                    if (m_piece.size() == piece_digits && !flush()) return false;
+                }
+                return true;
+            }
+
+            // @returns false if a character is not a digit of the radix
+            auto finish(Integer& out, bool neg) -> bool {
+                auto tail = block_vec_t(m_resource);
+                if (!parse_piece(tail)) return false;
+                if (m_stack.empty()) {
+                    vec_to_integer(out, tail, neg);
+                    return true;
+                }
+
+                auto acc = std::move(m_stack.front().value);
+                for (auto i = 1zu; i < m_stack.size(); ++i) {
+                    shift_in(acc, m_stack[i].value, piece_digits << m_stack[i].level);
+                }
+                if (!m_piece.empty()) shift_in(acc, tail, m_piece.size());
+                vec_to_integer(out, acc, neg);
+                return true;
+            }
+
+        private:
+            struct Piece {
+                block_vec_t value;
+                std::size_t level;
+            };
+
+            auto parse_piece(block_vec_t& v) -> bool {
+                v.assign(radix_digits_blocks(Radix, m_piece.size()), 0);
+                auto s = num_t(v.data(), v.size());
+                if (!parse_integer_to_block<Radix>(s, std::string_view(m_piece.data(), m_piece.size()), m_resource)) {
+                    return false;
+                }
+                vec_trim(v);
+                return true;
+            }
+
+            auto flush() -> bool {
+                auto piece = Piece{ block_vec_t(m_resource), 0 };
+                if (!parse_piece(piece.value)) return false;
+                m_piece.clear();
+                while (!m_stack.empty() && m_stack.back().level == piece.level) {
+                    auto left = std::move(m_stack.back().value);
+                    m_stack.pop_back();
+                    shift_in(left, piece.value, piece_digits << piece.level);
+                    piece.value = std::move(left);
+                    ++piece.level;
+                }
+                m_stack.push_back(std::move(piece));
+                return true;
+            }
+
+            // acc = acc * R^digits + low, with low < R^digits
+            auto shift_in(block_vec_t& acc, std::span<value_type const> low, std::size_t digits) -> void {
+                if constexpr (is_pow2) {
+                    constexpr auto pos = static_cast<std::size_t>(std::bit_width(Radix) - 1);
+                    vec_shift_left(m_tmp, acc, digits * pos);
+                } else {
+                    auto pow = block_vec_t(m_resource);
+                    vec_mul(m_tmp, acc, m_table.power_of(pow, digits), m_resource);
+                }
+                vec_add(m_tmp, low);
+                std::swap(acc, m_tmp);
+            }
+
+            RadixPowerTable<Radix> m_table;
+            std::pmr::vector<Piece> m_stack;
+            std::pmr::vector<char> m_piece;
+            block_vec_t m_tmp;
+            std::size_t m_digits{};
+            std::pmr::memory_resource* m_resource;
+        };
+
+        inline static constexpr auto is_digit_separator(char c) noexcept -> bool {
+            return c == '_' || c == ',' || c == ' ';
+        }
+
+        // Ends a run of digits: a separator or any whitespace.
+        inline static auto is_digit_break(char c) noexcept -> bool {
+            if (c > ' ') return c == '_' || c == ',';
+            return std::isspace(static_cast<unsigned char>(c));
+        }
+
+        /**
+         * Digits after the sign and radix prefix: `head` holds the ones already
+         * taken from the source and `chunk` the rest of the current chunk.
+         * Separators are dropped; whitespace other than ' ' ends the number and
+         * may only be followed by more whitespace.
+        */
+        template <std::size_t Radix, CharSource Source>
+        inline static auto parse_stream_body(
+            Integer& out,
+            bool neg,
+            std::string_view head,
+            std::string_view chunk,
+            Source& source,
+            std::string_view error,
+            std::string_view missing,
+            std::pmr::memory_resource* resource
+        ) -> std::expected<void, std::string_view> {
+            auto parser = StreamParser<Radix>(resource);
+            if (!parser.push(head)) return std::unexpected(error);
+
+            auto trailing = false;
+            while (true) {
+                while (!chunk.empty()) {
+                    if (trailing) {
+                        auto const ws = std::all_of(chunk.begin(), chunk.end(), [](char c) {
+                            return std::isspace(static_cast<unsigned char>(c));
+                        });
+                        if (!ws) return std::unexpected(error);
+                        break;
+                    }
+                    auto const n = static_cast<std::size_t>(std::find_if(chunk.begin(), chunk.end(), is_digit_break) - chunk.begin());
+                    if (!parser.push(chunk.substr(0, n))) return std::unexpected(error);
+                    chunk.remove_prefix(n);
+                    if (chunk.empty()) break;
+                    trailing = !is_digit_separator(chunk[0]);
+                    chunk.remove_prefix(1);
+                }
+                auto next = source.next();
+                if (!next) return std::unexpected(next.error());
+                chunk = *next;
+                if (chunk.empty()) break;
+            }
+
+            if (parser.digits() == 0) return std::unexpected(missing);
+            if (!parser.finish(out, neg)) return std::unexpected(error);
+            return {};
+        }
+    } // namespace detail
+
+    /**
+     * `parse_integer` for text that does not have to be in memory at once: it is
+     * pulled from `source` a chunk at a time and accepted with the same grammar,
+     * separators, prefixes and messages. Besides the chunk, the parser holds one
+     * basecase piece of text and the blocks of the value built so far, so even
+     * a file far larger than memory parses in about the space of its result.
+    */
+    template <CharSource Source>
+    inline static auto parse_integer_stream(
+        Integer& out,
+        Source& source,
+        std::uint8_t radix_hint = 0, // 0 -> auto detect
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> std::expected<void, std::string_view> {
+        out.set_bits(0);
+        out.set_neg(false);
+
+        // the sign, then up to two characters that settle the radix
+        auto head = std::array<char, 2>{};
+        auto hn = 0zu;
+        auto neg = false;
+        auto sign = false;
+        auto trailing = false;
+        auto chunk = std::string_view{};
+        while (true) {
+            if (chunk.empty()) {
+                auto next = source.next();
+                if (!next) return std::unexpected(next.error());
+                chunk = *next;
+                if (chunk.empty()) break;
+            }
+            auto const c = chunk[0];
+            chunk.remove_prefix(1);
+            if (c == '_' || c == ',') continue;
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                trailing = trailing || ((sign || hn > 0) && c != ' ');
+                continue;
+            }
+            if (trailing) return std::unexpected("Invalid decimal number");
+            if (!sign && hn == 0 && (c == '-' || c == '+')) {
+                sign = true;
+                neg = c == '-';
+                continue;
+            }
+            head[hn++] = c;
+            if (head[0] != '0' || hn == 2) break;
+        }
+
+        // nothing, a lone sign or a lone zero
+        if (hn == 0 || (head[0] == '0' && hn == 1)) return {};
+
+        if (head[0] == '0') {
+            switch (head[1]) {
+                case 'x': case 'X': {
+                    if (radix_hint == 0) radix_hint = 16;
+                    if (radix_hint != 16) return std::unexpected("Radix mismatch: expected radix to be base-16");
+                    return detail::parse_stream_body<16>(out, neg, {}, chunk, source, "Invalid hexadecimal number", "Missing number after radix prefix: '0x'", resource);
+                }
+                case 'b': case 'B': {
+                    if (radix_hint == 0) radix_hint = 2;
+                    if (radix_hint != 2) return std::unexpected("Radix mismatch: expected radix to be base-2");
+                    return detail::parse_stream_body<2>(out, neg, {}, chunk, source, "Invalid binary number", "Missing number after radix prefix: '0b'", resource);
+                }
+                case 'o': case 'O': {
+                    if (radix_hint == 0) radix_hint = 8;
+                    if (radix_hint != 8) return std::unexpected("Radix mismatch: expected radix to be base-8");
+                    return detail::parse_stream_body<8>(out, neg, {}, chunk, source, "Invalid octal number", "Missing number after radix prefix: '0o'", resource);
+                }
+                default: break;
+            }
+        }
+
+        if (radix_hint == 0) radix_hint = 10;
+        if (radix_hint != 10) return std::unexpected("Radix mismatch: expected radix to be base-10");
+        auto const digits = std::string_view(head.data(), hn);
+        return detail::parse_stream_body<10>(out, neg, digits, chunk, source, "Invalid decimal number", "Invalid decimal number", resource);
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_INTEGER_STREAM_HPP
@@ -0,0 +1,214 @@
+#ifndef AMT_BIG_NUM_INTERNAL_MOD_BARRETT_HPP
+#define AMT_BIG_NUM_INTERNAL_MOD_BARRETT_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../cmp.hpp"
+#include "../add_sub.hpp"
+#include "../div/schoolbook.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        /**
+         * Upper part of a product: out = floor(lhs * rhs / B^skip).
+         * Columns below `skip - 2` are never formed (HAC 14.44); what they would carry
+         * is less than B^skip as long as skip < B, so the result is short by at most one.
+        */
+        inline static constexpr auto barrett_mul_high(
+            std::span<Integer::value_type> out,
+            std::span<Integer::value_type const> lhs,
+            std::span<Integer::value_type const> rhs,
+            std::size_t skip
+        ) noexcept -> void {
+            using acc_t = MachineConfig::acc_t;
+            using val_t = Integer::value_type;
+            constexpr auto bits = MachineConfig::bits;
+            constexpr auto mask = MachineConfig::mask;
+
+            std::fill(out.begin(), out.end(), 0);
+            auto const start = skip > 2 ? skip - 2 : 0zu;
+
+            // Column-wise product; `lo` holds the partial column sum, `hi` the overflow.
+            auto lo = acc_t{};
+            auto hi = acc_t{};
+            auto const total = lhs.size() + rhs.size();
+            for (auto col = start; col < total; ++col) {
+                auto const ib = col >= rhs.size() ? col - rhs.size() + 1 : 0zu;
+                auto const ie = std::min(col + 1, lhs.size());
+                for (auto i = ib; i < ie; ++i) {
+                    lo += acc_t{lhs[i]} * rhs[col - i];
+                    hi += lo >> bits;
+                    lo &= mask;
+                }
+                if (col >= skip && col - skip < out.size()) {
+                    out[col - skip] = static_cast<val_t>(lo);
+                }
+                lo = hi & mask;
+                hi >>= bits;
+            }
+        }
+
+        // out = (lhs * rhs) mod B^(out.size())
+        inline static constexpr auto barrett_mul_low(
+            std::span<Integer::value_type> out,
+            std::span<Integer::value_type const> lhs,
+            std::span<Integer::value_type const> rhs
+        ) noexcept -> void {
+            using acc_t = MachineConfig::acc_t;
+            using val_t = Integer::value_type;
+            constexpr auto bits = MachineConfig::bits;
+            constexpr auto mask = MachineConfig::mask;
+
+            std::fill(out.begin(), out.end(), 0);
+            auto const n = out.size();
+            for (auto i = 0zu; i < std::min(lhs.size(), n); ++i) {
+                auto c = acc_t{};
+                auto const l = acc_t{lhs[i]};
+                auto const je = std::min(rhs.size(), n - i);
+                for (auto j = 0zu; j < je; ++j) {
+                    auto const t = l * rhs[j] + out[i + j] + c;
+                    out[i + j] = static_cast<val_t>(t & mask);
+                    c = t >> bits;
+                }
+                if (i + je < n) out[i + je] = static_cast<val_t>(c);
+            }
+        }
+    } // namespace detail
+
+    /**
+     * Barrett reduction by a fixed modulus (HAC 14.42).
+     * mu = floor(B^(2k) / m) is computed once; every reduction afterwards costs
+     * two truncated products and at most a few subtractions.
+    */
+    struct BarrettContext {
+        using value_type = Integer::value_type;
+        using size_type = std::size_t;
+
+        BarrettContext(
+            const_num_t const& modulus,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        )
+            : m_mod(resource)
+            , m_mu(resource)
+            , m_scratch(resource)
+        {
+            auto const m = modulus.trim_trailing_zeros();
+            assert(!m.empty() && "modulus cannot be zero");
+            auto const k = m.size();
+
+            m_mod.assign(m.begin(), m.end());
+            m_mu.resize(k + 2, 0);
+
+            std::pmr::vector<value_type> b2k(2 * k + 1, 0, resource);
+            b2k.back() = 1;
+            std::pmr::vector<value_type> rem(k, 0, resource);
+            schoolbook_div(
+                std::span(m_mu),
+                std::span(rem),
+                const_num_t(b2k.data(), b2k.size()),
+                m,
+                resource
+            );
+
+            m_scratch.resize(scratch_size(), 0);
+        }
+
+        constexpr auto size() const noexcept -> size_type { return m_mod.size(); }
+        constexpr auto modulus() const noexcept -> const_num_t { return { m_mod.data(), m_mod.size() }; }
+        constexpr auto reciprocal() const noexcept -> const_num_t { return { m_mu.data(), m_mu.size() }; }
+
+        // Number of blocks `reduce` needs as scratch space.
+        constexpr auto scratch_size() const noexcept -> size_type {
+            return 3 * (size() + 2);
+        }
+
+        /**
+         * out = x mod m, where 0 <= x < B^(2k) and out has at least k blocks.
+         * out may alias x; it is only written once the remainder is known.
+         * Uses the scratch owned by the context; use the overload taking scratch to
+         * share one context across threads.
+        */
+        constexpr auto reduce(
+            num_t out,
+            const_num_t const& x
+        ) noexcept -> void {
+            reduce(out, x, std::span(m_scratch));
+        }
+
+        constexpr auto reduce(
+            num_t out,
+            const_num_t const& x,
+            num_t scratch
+        ) const noexcept -> void {
+            using val_t = value_type;
+            auto const k = size();
+            auto const in = x.trim_trailing_zeros().span();
+            auto const m = std::span<val_t const>(m_mod);
+
+            assert(out.size() >= k);
+            assert(!x.is_neg() && "input must be non-negative");
+            assert(in.size() <= 2 * k && "input must be less than B^(2k)");
+            assert(scratch.size() >= scratch_size());
+
+            if (abs_compare(in, m) == std::strong_ordering::less) {
+                if (out.data() != in.data()) std::copy(in.begin(), in.end(), out.begin());
+                std::fill(out.begin() + static_cast<std::ptrdiff_t>(in.size()), out.end(), 0);
+                return;
+            }
+
+            auto q3 = scratch.span().subspan(0, k + 2);
+            auto r2 = scratch.span().subspan(k + 2, k + 1);
+            auto r = scratch.span().subspan(2 * k + 3, k + 2);
+
+            // q3 = floor(floor(x / B^(k - 1)) * mu / B^(k + 1))
+            auto const q1 = in.subspan(std::min(k - 1, in.size()));
+            detail::barrett_mul_high(q3, q1, m_mu, k + 1);
+
+            // r = (x mod B^(k + 1)) - (q3 * m mod B^(k + 1))
+            detail::barrett_mul_low(r2, q3, m);
+            std::fill(r.begin(), r.end(), 0);
+            auto const r1 = in.first(std::min(k + 1, in.size()));
+            std::copy(r1.begin(), r1.end(), r.begin());
+            // A borrow leaves the difference mod B^(k + 1) in the k + 1 blocks, which
+            // is already the remainder plus a small multiple of m (HAC 14.42 step 3).
+            abs_sub(num_t(r.data(), k + 1), const_num_t(r2.data(), r2.size()));
+            auto rs = num_t(r.data(), r.size());
+
+            // q3 is at most two short of floor(x / m) and the truncated product at most
+            // one more, so r < 4m.
+            [[maybe_unused]] auto steps = 0zu;
+            while (abs_compare(r, m) != std::strong_ordering::less) {
+                abs_sub(rs, const_num_t(m.data(), m.size()));
+                assert(++steps <= 3 && "Barrett quotient estimate is off by more than three");
+            }
+
+            std::copy_n(r.begin(), k, out.begin());
+            std::fill(out.begin() + static_cast<std::ptrdiff_t>(k), out.end(), 0);
+        }
+
+        auto reduce(
+            Integer& out,
+            Integer const& x
+        ) -> void {
+            // out may be x, so it is resized only after x is read
+            auto res = std::pmr::vector<value_type>(size(), 0, m_mod.get_allocator());
+            reduce(num_t(res.data(), res.size()), x.to_span());
+            out.resize(res.size() * MachineConfig::bits);
+            std::copy(res.begin(), res.end(), out.data());
+            out.set_neg(false);
+            out.remove_trailing_empty_blocks();
+        }
+
+    private:
+        std::pmr::vector<value_type> m_mod;
+        std::pmr::vector<value_type> m_mu;
+        std::pmr::vector<value_type> m_scratch;
+    };
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_MOD_BARRETT_HPP
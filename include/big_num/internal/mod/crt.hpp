@@ -0,0 +1,354 @@
+#ifndef AMT_BIG_NUM_INTERNAL_MOD_CRT_HPP
+#define AMT_BIG_NUM_INTERNAL_MOD_CRT_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include "../parallel.hpp"
+#include "product_tree.hpp"
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <memory_resource>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        // a^(-1) mod m for a block-sized m > 1 and gcd(a, m) = 1.
+        inline static constexpr auto invert_word(
+            MachineConfig::acc_t a,
+            MachineConfig::acc_t m
+        ) noexcept -> Integer::value_type {
+            using iacc_t = MachineConfig::iacc_t;
+            auto r0 = static_cast<iacc_t>(m);
+            auto r1 = static_cast<iacc_t>(a % m);
+            auto t0 = iacc_t{0};
+            auto t1 = iacc_t{1};
+            while (r1 != 0) {
+                auto const q = r0 / r1;
+                r0 = std::exchange(r1, r0 - q * r1);
+                t0 = std::exchange(t1, t0 - q * t1);
+            }
+            assert(r0 == 1 && "moduli have to be pairwise coprime");
+            if (t0 < 0) t0 += static_cast<iacc_t>(m);
+            return static_cast<Integer::value_type>(t0);
+        }
+    } // namespace detail
+
+    /**
+     * Everything Chinese remainder reconstruction needs for a fixed set of
+     * pairwise coprime block-sized moduli m_i, computed once:
+     * the product tree of the moduli and c_i = (M / m_i)^(-1) mod m_i, where M is
+     * the product of all of them.
+     *
+     * `reconstruct` gives the x in [0, M) with x = r_i mod m_i as
+     * sum((r_i c_i mod m_i) * M / m_i) mod M. The sum is formed up the product
+     * tree, a node's value being left * right_product + right * left_product, so
+     * every level costs about one product of its size. Up to
+     * `MachineConfig::crt_garner_threshold` moduli, Garner's mixed-radix form is
+     * used instead; its quadratic cost is only block operations.
+     *
+     * The basis is immutable after construction and can be shared between threads.
+     * Construction splits its work across `threads` (0 = all hardware threads);
+     * those threads allocate from `resource` concurrently, so it has to be
+     * thread-safe whenever `threads` is not 1.
+    */
+    struct CrtBasis {
+        using value_type = Integer::value_type;
+        using size_type = std::size_t;
+
+        CrtBasis(
+            std::span<value_type const> moduli,
+            std::size_t threads = 1,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        )
+            : m_mod(moduli.begin(), moduli.end(), resource)
+            , m_inv(moduli.size(), 0, resource)
+            , m_tree(as_integers(moduli, resource), threads, resource)
+        {
+            using acc_t = MachineConfig::acc_t;
+            auto const k = moduli.size();
+            for ([[maybe_unused]] auto m : moduli) assert(m > 1 && "modulus has to be greater than one");
+
+            if (uses_garner()) {
+                // m_inv[i] = (m_0 ... m_(i - 1))^(-1) mod m_i
+                for (auto i = 0zu; i < k; ++i) {
+                    auto const m = acc_t{moduli[i]};
+                    auto p = acc_t{1} % m;
+                    for (auto j = 0zu; j < i; ++j) p = (p * moduli[j]) % m;
+                    m_inv[i] = detail::invert_word(p, m);
+                }
+                return;
+            }
+
+            // M mod m_i^2 = m_i * ((M / m_i) mod m_i), from one remainder tree over the squares.
+            auto squares = std::pmr::vector<Integer>(resource);
+            squares.reserve(k);
+            auto sq = detail::block_vec_t(resource);
+            for (auto m : moduli) {
+                detail::vec_set(sq, acc_t{m} * m);
+                detail::vec_to_integer(squares.emplace_back(), sq);
+            }
+            auto const sq_tree = ProductTree(squares, threads, resource);
+
+            auto prod = Integer{};
+            auto const root = m_tree.root();
+            detail::vec_to_integer(prod, root.span());
+            auto rems = std::pmr::vector<Integer>(k, resource);
+            sq_tree.remainder_tree(rems, prod, threads, resource);
+
+            parallel_for(k, threads, [&](std::size_t b, std::size_t e) {
+                for (auto i = b; i < e; ++i) {
+                    auto const cof = detail::vec_get(rems[i].to_span().span()) / moduli[i];
+                    m_inv[i] = detail::invert_word(cof, moduli[i]);
+                }
+            });
+        }
+
+        constexpr auto size() const noexcept -> size_type { return m_mod.size(); }
+        constexpr auto moduli() const noexcept -> std::span<value_type const> { return m_mod; }
+        constexpr auto uses_garner() const noexcept -> bool { return size() <= MachineConfig::crt_garner_threshold; }
+
+        // Product of all the moduli.
+        constexpr auto product() const noexcept -> const_num_t { return m_tree.root(); }
+
+        // Number of blocks `reconstruct` needs as scratch space.
+        constexpr auto scratch_size() const noexcept -> size_type {
+            if (size() == 0) return 0;
+            if (uses_garner()) return size();
+            return 2 * level_size() + product().size() + 2;
+        }
+
+        /**
+         * out = x in [0, M) with x = residues[i] mod m_i; residues needs `size()` entries
+         * and out at least `product().size()` blocks. scratch needs `scratch_size()`
+         * blocks; `resource` only backs the products of the tree sum.
+        */
+        auto reconstruct(
+            num_t out,
+            std::span<value_type const> residues,
+            num_t scratch,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        ) const -> void {
+            assert(residues.size() >= size());
+            assert(out.size() >= product().size());
+            assert(scratch.size() >= scratch_size());
+            std::fill(out.begin(), out.end(), value_type{});
+            if (size() == 0) return;
+
+            if (uses_garner()) {
+                garner(out.span(), residues, scratch.span());
+            } else {
+                tree_sum(out.span(), residues, scratch.span(), resource);
+            }
+        }
+
+        /**
+         * Same as above into an Integer. out is resized to the product's size and
+         * written in place, so an Integer that is reused across calls keeps its storage.
+        */
+        auto reconstruct(
+            Integer& out,
+            std::span<value_type const> residues,
+            num_t scratch,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        ) const -> void {
+            auto const n = product().size();
+            out.resize(n * MachineConfig::bits);
+            reconstruct(num_t(out.data(), n), residues, scratch, resource);
+            out.remove_trailing_empty_blocks();
+            out.set_neg(false);
+        }
+
+        auto reconstruct(
+            Integer& out,
+            std::span<value_type const> residues,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        ) const -> void {
+            auto scratch = std::pmr::vector<value_type>(scratch_size(), 0, resource);
+            reconstruct(out, residues, std::span(scratch), resource);
+        }
+
+        /**
+         * Reconstructs `out.size()` integers; the residues of out[j] are
+         * residues[j * size(), (j + 1) * size()). Integers are split across
+         * `threads` (0 = all hardware threads), which share `resource` the same
+         * way the constructor does; each thread allocates its scratch once.
+        */
+        auto reconstruct_batch(
+            std::span<Integer> out,
+            std::span<value_type const> residues,
+            std::size_t threads = 1,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        ) const -> void {
+            auto const k = size();
+            assert(residues.size() >= out.size() * k);
+            parallel_for(out.size(), threads, [&](std::size_t b, std::size_t e) {
+                auto scratch = std::pmr::vector<value_type>(scratch_size(), 0, resource);
+                for (auto j = b; j < e; ++j) {
+                    reconstruct(out[j], residues.subspan(j * k, k), std::span(scratch), resource);
+                }
+            });
+        }
+
+    private:
+        static auto as_integers(
+            std::span<value_type const> moduli,
+            std::pmr::memory_resource* resource
+        ) -> std::pmr::vector<Integer> {
+            auto res = std::pmr::vector<Integer>(moduli.size(), resource);
+            for (auto i = 0zu; i < moduli.size(); ++i) {
+                detail::vec_to_integer(res[i], std::span(moduli.data() + i, 1));
+            }
+            return res;
+        }
+
+        // x = x * w + c; returns what is carried out of the top block.
+        static constexpr auto mul_word_add(
+            std::span<value_type> x,
+            value_type w,
+            MachineConfig::acc_t c
+        ) noexcept -> MachineConfig::acc_t {
+            for (auto& v : x) {
+                auto const t = MachineConfig::acc_t{v} * w + c;
+                v = static_cast<value_type>(t & MachineConfig::mask);
+                c = t >> MachineConfig::bits;
+            }
+            return c;
+        }
+
+        /**
+         * Blocks of the largest level of the tree sum. A node's value is below the
+         * number of its leaves times its product, and a product of two children is
+         * at most one block longer than their parent, so every node gets two blocks
+         * more than its product.
+        */
+        constexpr auto level_size() const noexcept -> size_type {
+            auto res = 0zu;
+            auto count = size();
+            for (auto l = 0zu; l < m_tree.levels(); ++l, count = (count + 1) / 2) {
+                auto sum = 0zu;
+                for (auto j = 0zu; j < count; ++j) sum += m_tree.node(l, j).size() + 2;
+                res = std::max(res, sum);
+            }
+            return res;
+        }
+
+        /**
+         * Mixed radix digits v_i with x = v_0 + v_1 m_0 + v_2 m_0 m_1 + ...;
+         * v_i = (r_i - (v_0 + ... + v_(i - 1) m_0 ... m_(i - 2))) (m_0 ... m_(i - 1))^(-1) mod m_i.
+         * out has to be zero filled; the digits take `size()` blocks of scratch.
+        */
+        auto garner(
+            std::span<value_type> out,
+            std::span<value_type const> residues,
+            std::span<value_type> scratch
+        ) const noexcept -> void {
+            using acc_t = MachineConfig::acc_t;
+            auto const k = size();
+            auto v = scratch.first(k);
+            for (auto i = 0zu; i < k; ++i) {
+                auto const m = acc_t{m_mod[i]};
+                auto s = acc_t{};
+                for (auto j = i; j > 0; --j) s = (s * m_mod[j - 1] + v[j - 1]) % m;
+                auto const r = acc_t{residues[i]} % m;
+                v[i] = static_cast<value_type>(((r + m - s) % m) * m_inv[i] % m);
+            }
+
+            // Horner from the top digit; x stays below M, so it fits in out.
+            auto len = 0zu;
+            for (auto i = k; i > 0; --i) {
+                auto c = mul_word_add(out.first(len), m_mod[i - 1], v[i - 1]);
+                for (; c; c >>= MachineConfig::bits) {
+                    out[len++] = static_cast<value_type>(c & MachineConfig::mask);
+                }
+            }
+        }
+
+        /**
+         * x = sum(w_i * M / m_i) mod M with w_i = r_i c_i mod m_i, the sum accumulated up
+         * the product tree. The sum is below size() * M and its quotient by M is
+         * floor(sum(w_i / m_i)), which a double gets to within one; so the last step
+         * is a word multiple of M and a correction instead of a division.
+         * Every level is laid out in one half of scratch, nodes in order and each
+         * `node.size() + 2` blocks long, and the next level is built in the other half.
+        */
+        auto tree_sum(
+            std::span<value_type> out,
+            std::span<value_type const> residues,
+            std::span<value_type> scratch,
+            std::pmr::memory_resource* resource
+        ) const -> void {
+            using acc_t = MachineConfig::acc_t;
+            auto const n = product().size();
+            auto const level = level_size();
+            auto cur = scratch.subspan(0, level);
+            auto next = scratch.subspan(level, level);
+            auto t = scratch.subspan(2 * level, n + 2);
+
+            // out = trim(a) * b; out is zero filled and long enough for the product
+            auto term = [resource](std::span<value_type> out, std::span<value_type const> a, const_num_t b) {
+                auto const x = const_num_t(a.data(), a.size()).trim_trailing_zeros();
+                if (x.empty()) return;
+                mul_unbalanced(num_t(out.data(), x.size() + b.size()), x, b, resource);
+            };
+
+            auto frac = 0.0;
+            for (auto i = 0zu, off = 0zu; i < size(); ++i) {
+                auto const m = acc_t{m_mod[i]};
+                auto const w = (acc_t{residues[i]} % m) * m_inv[i] % m;
+                auto const leaf = cur.subspan(off, m_tree.node(0, i).size() + 2);
+                std::fill(leaf.begin(), leaf.end(), value_type{});
+                leaf[0] = static_cast<value_type>(w);
+                off += leaf.size();
+                frac += static_cast<double>(w) / static_cast<double>(m);
+            }
+
+            auto count = size();
+            for (auto l = 0zu; l + 1 < m_tree.levels(); ++l, count = (count + 1) / 2) {
+                auto in = 0zu;
+                auto o = 0zu;
+                for (auto j = 0zu; 2 * j < count; ++j) {
+                    auto const left = cur.subspan(in, m_tree.node(l, 2 * j).size() + 2);
+                    auto const dst = next.subspan(o, m_tree.node(l + 1, j).size() + 2);
+                    in += left.size();
+                    o += dst.size();
+                    if (m_tree.is_carried(l, 2 * j)) {
+                        std::copy(left.begin(), left.end(), dst.begin());
+                        continue;
+                    }
+
+                    auto const right = cur.subspan(in, m_tree.node(l, 2 * j + 1).size() + 2);
+                    in += right.size();
+                    auto const tmp = t.first(dst.size());
+                    std::fill(dst.begin(), dst.end(), value_type{});
+                    std::fill(tmp.begin(), tmp.end(), value_type{});
+                    term(dst, left, m_tree.node(l, 2 * j + 1));
+                    term(tmp, right, m_tree.node(l, 2 * j));
+                    abs_add(num_t(dst.data(), dst.size()), const_num_t(tmp.data(), tmp.size()));
+                }
+                std::swap(cur, next);
+            }
+
+            auto const x = cur.first(n + 2);
+            auto const m = product();
+            auto const q = static_cast<value_type>(frac);
+            std::fill(t.begin(), t.end(), value_type{});
+            std::copy(m.begin(), m.end(), t.begin());
+            mul_word_add(t, q, 0);
+            while (abs_compare(t, x) == std::strong_ordering::greater) abs_sub(num_t(t.data(), t.size()), m);
+            abs_sub(num_t(x.data(), x.size()), const_num_t(t.data(), t.size()));
+            while (abs_compare(x, m.span()) != std::strong_ordering::less) abs_sub(num_t(x.data(), x.size()), m);
+            std::copy_n(x.begin(), n, out.begin());
+        }
+
+        std::pmr::vector<value_type> m_mod;
+        // c_i for the tree sum, or Garner's prefix inverses
+        std::pmr::vector<value_type> m_inv;
+        ProductTree m_tree;
+    };
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_MOD_CRT_HPP
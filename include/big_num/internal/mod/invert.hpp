@@ -0,0 +1,172 @@
+#ifndef AMT_BIG_NUM_INTERNAL_MOD_INVERT_HPP
+#define AMT_BIG_NUM_INTERNAL_MOD_INVERT_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../cmp.hpp"
+#include "../add_sub.hpp"
+#include "../div/mod.hpp"
+#include "../gcd/gcdext.hpp"
+#include "../mul/mul.hpp"
+#include "barrett.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        // out = a mod m in [0, m) for a signed a; out has m.size() blocks.
+        inline static constexpr auto invert_residue(
+            std::span<Integer::value_type> out,
+            const_num_t const& a,
+            const_num_t const& m,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            mod(num_t(out.data(), out.size()), a.abs(), m, resource);
+            auto const r = num_t(out.data(), out.size());
+            if (a.is_neg() && !r.trim_trailing_zeros().empty()) {
+                // m - r
+                std::pmr::vector<Integer::value_type> t(m.begin(), m.end(), resource);
+                t.resize(out.size(), 0);
+                abs_sub(num_t(t.data(), t.size()), const_num_t(out.data(), out.size()));
+                std::copy(t.begin(), t.end(), out.begin());
+            }
+        }
+    } // namespace detail
+
+    /**
+     * out = a^(-1) mod m in [0, m).
+     * Runs the extended gcd on (a mod m, m) and only builds the cofactor of a.
+     * out needs `m.size()` blocks.
+     * @returns true if successful; otherwise false if m is zero or gcd(a, m) != 1
+    */
+    inline static constexpr auto invert(
+        num_t out,
+        const_num_t const& a,
+        const_num_t const& m,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        using val_t = Integer::value_type;
+        auto const md = m.trim_trailing_zeros();
+        if (md.empty()) return false;
+        auto const k = md.size();
+        assert(out.size() >= k);
+
+        std::pmr::vector<val_t> buff(2 * k + detail::GcdMatrix::storage_size(k + 1) + detail::gcdext_scratch_size(k), 0, resource);
+        auto rest = std::span(buff);
+        auto x = detail::gcd_take(rest, k);
+        auto y = detail::gcd_take(rest, k);
+        detail::invert_residue(x, a, md, resource);
+        std::copy(md.begin(), md.end(), y.begin());
+
+        auto cf = detail::GcdCofactors(detail::gcd_take(rest, detail::GcdMatrix::storage_size(k + 1)), k + 1, true, false);
+        auto const in_a = detail::gcdext_reduce(x, y, cf, rest, resource);
+        auto const g = in_a ? x : y;
+        if (g.size() != 1 || g[0] != 1) return false;
+
+        // 1 = m11 * x - m01 * m or 1 = m00 * m - m10 * x
+        auto const s = in_a ? cf.mat.m[3] : cf.mat.m[2];
+        std::fill(out.begin(), out.end(), 0);
+        auto r = std::pmr::vector<val_t>(k, 0, resource);
+        mod(num_t(r.data(), k), const_num_t(s.data(), s.size()), md, resource);
+        auto const zero = num_t(r.data(), k).trim_trailing_zeros().empty();
+        if (in_a || zero) {
+            std::copy(r.begin(), r.end(), out.begin());
+        } else {
+            std::copy(md.begin(), md.end(), out.begin());
+            abs_sub(num_t(out.data(), k), const_num_t(r.data(), k));
+        }
+        return true;
+    }
+
+    /**
+     * @returns true if successful; otherwise false if m is zero or gcd(a, m) != 1
+    */
+    inline static constexpr auto invert(
+        Integer& out,
+        Integer const& a,
+        Integer const& m,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        if (m.empty()) return false;
+        auto const k = m.size();
+        std::pmr::vector<Integer::value_type> r(k, 0, resource);
+        if (!invert(num_t(r.data(), k), a.to_span(), m.to_span(), resource)) return false;
+        out.resize(k * MachineConfig::bits);
+        std::copy(r.begin(), r.end(), out.data());
+        out.set_neg(false);
+        out.remove_trailing_empty_blocks();
+        return true;
+    }
+
+    /**
+     * out[i] = in[i]^(-1) mod m for every i with Montgomery's trick: one inversion of
+     * the product of all inputs plus 3(N - 1) multiplications, each followed by a
+     * Barrett reduction. out may alias in.
+     * @returns true if successful; otherwise false if m is zero or some input is not
+     *          invertible, in which case out is left untouched
+    */
+    inline static auto invert_batch(
+        std::span<Integer> out,
+        std::span<Integer const> in,
+        Integer const& m,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        using val_t = Integer::value_type;
+        assert(out.size() >= in.size());
+        if (m.empty()) return false;
+        auto const n = in.size();
+        if (n == 0) return true;
+
+        auto ctx = BarrettContext(m.to_span(), resource);
+        auto const k = ctx.size();
+        auto const md = ctx.modulus();
+
+        // res[i] = in[i] mod m, pre[i] = res[0] * ... * res[i] mod m
+        std::pmr::vector<val_t> res(n * k, 0, resource);
+        std::pmr::vector<val_t> pre(n * k, 0, resource);
+        std::pmr::vector<val_t> prod(2 * k, 0, resource);
+        std::pmr::vector<val_t> inv(k, 0, resource);
+        auto at = [k](std::pmr::vector<val_t>& v, std::size_t i) { return num_t(v.data() + i * k, k); };
+        auto cat = [k](std::pmr::vector<val_t> const& v, std::size_t i) { return const_num_t(v.data() + i * k, k); };
+
+        auto mul_mod = [&](num_t dst, const_num_t lhs, const_num_t rhs) {
+            std::fill(prod.begin(), prod.end(), 0);
+            mul(num_t(prod.data(), prod.size()), lhs, rhs, resource);
+            ctx.reduce(dst, const_num_t(prod.data(), prod.size()));
+        };
+
+        for (auto i = 0zu; i < n; ++i) {
+            detail::invert_residue(at(res, i).span(), in[i].to_span(), md, resource);
+        }
+
+        std::copy_n(res.begin(), k, pre.begin());
+        for (auto i = 1zu; i < n; ++i) {
+            mul_mod(at(pre, i), cat(pre, i - 1), cat(res, i));
+        }
+
+        if (!invert(num_t(inv.data(), k), cat(pre, n - 1), md, resource)) return false;
+
+        auto tmp = std::pmr::vector<val_t>(k, 0, resource);
+        auto store = [&](std::size_t i, const_num_t v) {
+            auto& o = out[i];
+            o.resize(k * MachineConfig::bits);
+            std::copy(v.begin(), v.end(), o.data());
+            o.set_neg(false);
+            o.remove_trailing_empty_blocks();
+        };
+
+        for (auto i = n - 1; i > 0; --i) {
+            // in[i]^(-1) = inv * pre[i - 1]; then drop in[i] from inv
+            mul_mod(num_t(tmp.data(), k), const_num_t(inv.data(), k), cat(pre, i - 1));
+            mul_mod(num_t(inv.data(), k), const_num_t(inv.data(), k), cat(res, i));
+            store(i, const_num_t(tmp.data(), k));
+        }
+        store(0, const_num_t(inv.data(), k));
+        return true;
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_MOD_INVERT_HPP
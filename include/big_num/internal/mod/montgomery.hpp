@@ -0,0 +1,369 @@
+#ifndef AMT_BIG_NUM_INTERNAL_MOD_MONTGOMERY_HPP
+#define AMT_BIG_NUM_INTERNAL_MOD_MONTGOMERY_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../cmp.hpp"
+#include "../div/schoolbook.hpp"
+#include "ui.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        // -m^(-1) mod B, m has to be odd.
+        inline static constexpr auto mont_neg_inverse(
+            Integer::value_type m
+        ) noexcept -> Integer::value_type {
+            using acc_t = MachineConfig::acc_t;
+            assert((m & 1) && "modulus has to be odd");
+            // Newton iteration doubles the number of correct bits each step.
+            auto x = acc_t{m};
+            for (auto i = 0zu; i < 6; ++i) {
+                x = (x * (2 - acc_t{m} * x)) & MachineConfig::mask;
+            }
+            return static_cast<Integer::value_type>((MachineConfig::max - x) & MachineConfig::mask);
+        }
+
+        /**
+         * Branch-free final step of a Montgomery product.
+         * t = [t_0, ..., t_k] < 2m; out = t >= m ? t - m : t
+        */
+        inline static constexpr auto mont_final_sub(
+            std::span<Integer::value_type> out,
+            std::span<Integer::value_type const> t,
+            std::span<Integer::value_type const> m
+        ) noexcept -> void {
+            using acc_t = MachineConfig::acc_t;
+            using val_t = Integer::value_type;
+            auto const k = m.size();
+
+            auto borrow = acc_t{};
+            for (auto i = 0zu; i < k; ++i) {
+                auto const d = acc_t{t[i]} - m[i] - borrow;
+                out[i] = static_cast<val_t>(d & MachineConfig::mask);
+                borrow = d >> (sizeof(acc_t) * 8 - 1);
+            }
+            borrow = (acc_t{t[k]} - borrow) >> (sizeof(acc_t) * 8 - 1);
+
+            // borrow == 1 => t < m, keep t
+            auto const keep = static_cast<val_t>(0) - static_cast<val_t>(borrow);
+            for (auto i = 0zu; i < k; ++i) {
+                out[i] = static_cast<val_t>((t[i] & keep) | (out[i] & ~keep));
+            }
+        }
+    } // namespace detail
+
+    /**
+     * Montgomery arithmetic for an odd multi-block modulus m with R = B^k.
+     *
+     * The product is computed in the CIOS order but kept in a redundant form:
+     * every 64-bit lane holds a 31-bit digit plus up to three carry bits. The spare
+     * bit in each block lets `t_j + a_j * b_i + q * m_j` stay within the accumulator,
+     * so the inner loop has no carry chain and runs lane-wise on `simd_acc_t`;
+     * carries are resolved once at the end.
+    */
+    struct MontgomeryContext {
+        using value_type = Integer::value_type;
+        using acc_t = MachineConfig::acc_t;
+        using size_type = std::size_t;
+
+        MontgomeryContext(
+            const_num_t const& modulus,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        )
+            : m_mod(resource)
+            , m_mod_wide(resource)
+            , m_r2(resource)
+            , m_one(resource)
+            , m_scratch(resource)
+            , m_wide_scratch(resource)
+        {
+            auto const m = modulus.trim_trailing_zeros();
+            assert(!m.empty() && "modulus cannot be zero");
+            auto const k = m.size();
+
+            m_mod.assign(m.begin(), m.end());
+            m_mod_wide.assign(m.begin(), m.end());
+            m_inv = detail::mont_neg_inverse(m[0]);
+
+            // R^2 mod m
+            std::pmr::vector<value_type> r2(2 * k + 1, 0, resource);
+            r2.back() = 1;
+            m_r2.resize(k, 0);
+            schoolbook_div(num_t{}, std::span(m_r2), const_num_t(r2.data(), r2.size()), m, resource);
+
+            // R mod m, Montgomery form of one
+            std::fill(r2.begin(), r2.end(), 0);
+            r2[k] = 1;
+            m_one.resize(k, 0);
+            schoolbook_div(num_t{}, std::span(m_one), const_num_t(r2.data(), k + 1), m, resource);
+
+            m_scratch.resize(scratch_size(), 0);
+            m_wide_scratch.resize(wide_scratch_size(), 0);
+        }
+
+        constexpr auto size() const noexcept -> size_type { return m_mod.size(); }
+        constexpr auto modulus() const noexcept -> const_num_t { return { m_mod.data(), m_mod.size() }; }
+        constexpr auto inverse() const noexcept -> value_type { return m_inv; }
+        constexpr auto r2() const noexcept -> const_num_t { return { m_r2.data(), m_r2.size() }; }
+        // R mod m, i.e. one in Montgomery form.
+        constexpr auto one() const noexcept -> const_num_t { return { m_one.data(), m_one.size() }; }
+
+        // Number of blocks the operations need as scratch space.
+        constexpr auto scratch_size() const noexcept -> size_type {
+            return 2 * size() + 2;
+        }
+
+        // Number of accumulator lanes `mont_mul` keeps its redundant product in.
+        constexpr auto wide_scratch_size() const noexcept -> size_type {
+            return size() + 1;
+        }
+
+        /**
+         * out = a * b * R^(-1) mod m
+         * a and b have to be below m, i.e. reduced Montgomery forms: the single final
+         * subtraction only covers a * b < mR. out needs k blocks and may alias a or b.
+        */
+        constexpr auto mont_mul(
+            num_t out,
+            const_num_t const& a,
+            const_num_t const& b,
+            num_t scratch,
+            std::span<acc_t> wide
+        ) const noexcept -> void {
+            using val_t = value_type;
+            auto const k = size();
+            assert(scratch.size() >= scratch_size());
+            assert(wide.size() >= wide_scratch_size());
+            assert(out.size() >= k);
+
+            auto const t = wide.data();
+            auto const tmp = scratch.span();
+            auto const as = operand(a);
+            auto const bs = operand(b);
+            assert(abs_compare(as, m_mod) == std::strong_ordering::less);
+            assert(abs_compare(bs, m_mod) == std::strong_ordering::less);
+
+            std::fill_n(t, k + 1, acc_t{});
+            // zero-extended copy of a so the row update can run over all k lanes
+            auto aw = tmp.first(k);
+            std::fill(aw.begin(), aw.end(), 0);
+            std::copy(as.begin(), as.end(), aw.begin());
+
+            for (auto i = 0zu; i < k; ++i) {
+                auto const bi = acc_t{i < bs.size() ? bs[i] : val_t{}};
+                auto const q = (((t[0] + acc_t{aw[0]} * bi) & MachineConfig::mask) * m_inv) & MachineConfig::mask;
+                row_update(t, aw.data(), bi, q);
+            }
+
+            normalize(tmp.first(k + 1), t);
+            detail::mont_final_sub(out.span(), tmp.first(k + 1), m_mod);
+        }
+
+        /**
+         * out = a^2 * R^(-1) mod m, a below m in Montgomery form; out may alias a.
+         * Forms the full square with the symmetric cross products once and then
+         * runs a separate reduction, which saves about half of the block products.
+        */
+        constexpr auto mont_sqr(
+            num_t out,
+            const_num_t const& a,
+            num_t scratch
+        ) const noexcept -> void {
+            using val_t = value_type;
+            constexpr auto bits = MachineConfig::bits;
+            constexpr auto mask = MachineConfig::mask;
+            auto const k = size();
+            assert(scratch.size() >= scratch_size());
+            assert(out.size() >= k);
+
+            auto t = scratch.span().first(2 * k + 2);
+            auto const as = operand(a);
+            assert(abs_compare(as, m_mod) == std::strong_ordering::less);
+            auto const n = as.size();
+            std::fill(t.begin(), t.end(), 0);
+
+            // cross terms a_i * a_j, i < j
+            for (auto i = 0zu; i < n; ++i) {
+                auto c = acc_t{};
+                auto const ai = acc_t{as[i]};
+                for (auto j = i + 1; j < n; ++j) {
+                    auto const s = ai * as[j] + t[i + j] + c;
+                    t[i + j] = static_cast<val_t>(s & mask);
+                    c = s >> bits;
+                }
+                t[i + n] = static_cast<val_t>(c);
+            }
+
+            // double the cross terms and add the diagonal
+            auto c = acc_t{};
+            for (auto i = 0zu; i < n; ++i) {
+                auto const d = acc_t{as[i]} * as[i];
+                auto const lo = (acc_t{t[2 * i]} << 1) + (d & mask) + c;
+                t[2 * i] = static_cast<val_t>(lo & mask);
+                auto const hi = (acc_t{t[2 * i + 1]} << 1) + (d >> bits) + (lo >> bits);
+                t[2 * i + 1] = static_cast<val_t>(hi & mask);
+                c = hi >> bits;
+            }
+            assert(c == 0);
+
+            redc(out.span(), t);
+        }
+
+        /**
+         * Montgomery reduction of t = [t_0, ..., t_(2k + 1)] < mR.
+         * t is consumed; out = t * R^(-1) mod m.
+        */
+        constexpr auto redc(
+            std::span<value_type> out,
+            std::span<value_type> t
+        ) const noexcept -> void {
+            using val_t = value_type;
+            constexpr auto bits = MachineConfig::bits;
+            constexpr auto mask = MachineConfig::mask;
+            auto const k = size();
+            assert(t.size() >= 2 * k + 1);
+
+            // carry into t_(i + k + 1) that is still owed from the previous row
+            auto top = acc_t{};
+            for (auto i = 0zu; i < k; ++i) {
+                auto const q = (acc_t{t[i]} * m_inv) & mask;
+                auto c = acc_t{};
+                for (auto j = 0zu; j < k; ++j) {
+                    auto const s = q * m_mod[j] + t[i + j] + c;
+                    t[i + j] = static_cast<val_t>(s & mask);
+                    c = s >> bits;
+                }
+                auto const s = acc_t{t[i + k]} + c + top;
+                t[i + k] = static_cast<val_t>(s & mask);
+                top = s >> bits;
+            }
+            t[2 * k] = static_cast<val_t>(acc_t{t[2 * k]} + top);
+
+            detail::mont_final_sub(out, t.subspan(k, k + 1), m_mod);
+        }
+
+        // out = a * R mod m, a < m
+        constexpr auto to_mont(
+            num_t out,
+            const_num_t const& a,
+            num_t scratch,
+            std::span<acc_t> wide
+        ) const noexcept -> void {
+            mont_mul(out, a, r2(), scratch, wide);
+        }
+
+        // out = a * R^(-1) mod m
+        constexpr auto from_mont(
+            num_t out,
+            const_num_t const& a,
+            num_t scratch
+        ) const noexcept -> void {
+            auto t = scratch.span().first(2 * size() + 2);
+            auto const as = operand(a);
+            std::fill(t.begin(), t.end(), 0);
+            std::copy(as.begin(), as.end(), t.begin());
+            redc(out.span(), t);
+        }
+
+        constexpr auto mont_mul(num_t out, const_num_t const& a, const_num_t const& b) noexcept -> void {
+            mont_mul(out, a, b, std::span(m_scratch), std::span(m_wide_scratch));
+        }
+
+        constexpr auto mont_sqr(num_t out, const_num_t const& a) noexcept -> void {
+            mont_sqr(out, a, std::span(m_scratch));
+        }
+
+        constexpr auto to_mont(num_t out, const_num_t const& a) noexcept -> void {
+            to_mont(out, a, std::span(m_scratch), std::span(m_wide_scratch));
+        }
+
+        constexpr auto from_mont(num_t out, const_num_t const& a) noexcept -> void {
+            from_mont(out, a, std::span(m_scratch));
+        }
+
+    private:
+        /**
+         * Operands that already span k blocks are used as is so that the
+         * operation count depends only on the modulus size, not on the value.
+        */
+        constexpr auto operand(
+            const_num_t const& a
+        ) const noexcept -> std::span<value_type const> {
+            if (a.size() <= size()) return a.span();
+            auto const t = a.trim_trailing_zeros().span();
+            assert(t.size() <= size());
+            return t;
+        }
+
+        /**
+         * t_j <- t_j + a_j * b_i + q * m_j, followed by a one block shift where the
+         * low digit of each lane is joined with the carry bits of its lower neighbour.
+        */
+        constexpr auto row_update(
+            acc_t* t,
+            value_type const* a,
+            acc_t bi,
+            acc_t q
+        ) const noexcept -> void {
+            constexpr auto bits = MachineConfig::bits;
+            constexpr auto mask = MachineConfig::mask;
+            auto const k = size();
+            auto const n = m_mod_wide.data();
+
+            auto j = 0zu;
+            if (!std::is_constant_evaluated()) {
+                using simd_t = MachineConfig::simd_acc_t;
+                static constexpr auto N = simd_t::elements;
+                acc_t aw[N];
+                auto const vb = simd_t::load(bi);
+                auto const vq = simd_t::load(q);
+                auto const sz = k - k % N;
+                for (; j < sz; j += N) {
+                    std::copy_n(a + j, N, aw);
+                    auto v = simd_t::load(t + j, N);
+                    v = v + simd_t::load(aw, N) * vb + simd_t::load(n + j, N) * vq;
+                    v.store(t + j, N);
+                }
+            }
+            for (; j < k; ++j) {
+                t[j] += acc_t{a[j]} * bi + q * n[j];
+            }
+
+            // t_0 is divisible by B; shift down by one block.
+            for (j = 0; j < k; ++j) {
+                t[j] = (t[j + 1] & mask) + (t[j] >> bits);
+            }
+            t[k] >>= bits;
+        }
+
+        // Resolves the lane carries of the redundant accumulator into blocks.
+        constexpr auto normalize(
+            std::span<value_type> out,
+            acc_t const* t
+        ) const noexcept -> void {
+            auto c = acc_t{};
+            for (auto j = 0zu; j < out.size(); ++j) {
+                auto const s = t[j] + c;
+                out[j] = static_cast<value_type>(s & MachineConfig::mask);
+                c = s >> MachineConfig::bits;
+            }
+            assert(c == 0);
+        }
+
+        std::pmr::vector<value_type> m_mod;
+        std::pmr::vector<acc_t> m_mod_wide;
+        std::pmr::vector<value_type> m_r2;
+        std::pmr::vector<value_type> m_one;
+        std::pmr::vector<value_type> m_scratch;
+        std::pmr::vector<acc_t> m_wide_scratch;
+        value_type m_inv{};
+    };
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_MOD_MONTGOMERY_HPP
@@ -0,0 +1,376 @@
+#ifndef AMT_BIG_NUM_INTERNAL_MOD_POWM_HPP
+#define AMT_BIG_NUM_INTERNAL_MOD_POWM_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../cmp.hpp"
+#include "../logical_bitwise.hpp"
+#include "../div/schoolbook.hpp"
+#include "../mul/mul.hpp"
+#include "barrett.hpp"
+#include "montgomery.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        // Sliding window size for an exponent of `bits` bits.
+        inline static constexpr auto powm_window_bits(std::size_t bits) noexcept -> std::size_t {
+            if (bits > 671) return 6;
+            if (bits > 239) return 5;
+            if (bits > 79) return 4;
+            if (bits > 23) return 3;
+            return 1;
+        }
+
+        // Bits [lo, lo + w) of the exponent; no branches on the exponent value.
+        inline static constexpr auto powm_exp_window(
+            std::span<Integer::value_type const> e,
+            std::size_t lo,
+            std::size_t w
+        ) noexcept -> std::size_t {
+            auto const block = lo / MachineConfig::bits;
+            auto const index = lo % MachineConfig::bits;
+            auto v = block < e.size() ? MachineConfig::acc_t{e[block]} : MachineConfig::acc_t{};
+            if (block + 1 < e.size()) v |= MachineConfig::acc_t{e[block + 1]} << MachineConfig::bits;
+            return static_cast<std::size_t>((v >> index) & ((MachineConfig::acc_t{1} << w) - 1));
+        }
+
+        // out = base mod m in [0, m) for a signed base; out has m.size() blocks.
+        inline static constexpr auto powm_reduce_base(
+            std::span<Integer::value_type> out,
+            const_num_t const& base,
+            const_num_t const& mod,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            using acc_t = MachineConfig::acc_t;
+            std::fill(out.begin(), out.end(), 0);
+            schoolbook_div(num_t{}, out, base.abs(), mod, resource);
+            if (!base.is_neg() || std::all_of(out.begin(), out.end(), [](auto v) { return v == 0; })) return;
+
+            // m - r, in place
+            auto borrow = acc_t{};
+            for (auto i = 0zu; i < out.size(); ++i) {
+                auto const d = acc_t{mod[i]} - out[i] - borrow;
+                out[i] = static_cast<Integer::value_type>(d & MachineConfig::mask);
+                borrow = (d >> MachineConfig::bits) & 1;
+            }
+        }
+
+        // Sliding window powering with Barrett reduction for even moduli; same window as `powm_sliding`.
+        inline static constexpr auto powm_barrett(
+            num_t out,
+            const_num_t const& base,
+            const_num_t const& exp,
+            const_num_t const& mod,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            using val_t = Integer::value_type;
+            auto ctx = BarrettContext(mod, resource);
+            auto const k = ctx.size();
+
+            auto const e = exp.trim_trailing_zeros();
+            auto const bits = e.bits();
+            auto const w = powm_window_bits(bits);
+            auto const table_size = 1zu << (w - 1);
+
+            std::pmr::vector<val_t> buff((table_size + 4) * k + ctx.scratch_size(), 0, resource);
+            auto acc = std::span(buff.data(), k);
+            auto g2 = std::span(buff.data() + k, k);
+            auto prod = std::span(buff.data() + 2 * k, 2 * k);
+            auto scratch = std::span(buff.data() + (table_size + 4) * k, ctx.scratch_size());
+            auto table = [&buff, k](std::size_t i) { return std::span(buff.data() + (i + 4) * k, k); };
+
+            // modulus is even, so it is at least 2
+            acc[0] = 1;
+
+            auto const sqr_into = [&](std::span<val_t> r, std::span<val_t> a) {
+                std::fill(prod.begin(), prod.end(), 0);
+                square(prod, const_num_t(a.data(), k), resource);
+                ctx.reduce(r, const_num_t(prod.data(), prod.size()), scratch);
+            };
+            auto const mul_into = [&](std::span<val_t> r, std::span<val_t> a, std::span<val_t> b) {
+                std::fill(prod.begin(), prod.end(), 0);
+                mul(prod, const_num_t(a.data(), k), const_num_t(b.data(), k), resource);
+                ctx.reduce(r, const_num_t(prod.data(), prod.size()), scratch);
+            };
+
+            // table[i] = base^(2i + 1) mod m
+            powm_reduce_base(table(0), base, mod, resource);
+            sqr_into(g2, table(0));
+            for (auto i = 1zu; i < table_size; ++i) mul_into(table(i), table(i - 1), g2);
+
+            auto started = false;
+            auto i = bits;
+            while (i > 0) {
+                if (!get_integer_bit(e, i - 1)) {
+                    if (started) sqr_into(acc, acc);
+                    --i;
+                    continue;
+                }
+
+                // longest window [l, i) that ends with a set bit
+                auto l = std::max(i, w) - w;
+                while (!get_integer_bit(e, l)) ++l;
+                auto const val = powm_exp_window(e, l, i - l);
+
+                if (started) {
+                    for (auto j = l; j < i; ++j) sqr_into(acc, acc);
+                    mul_into(acc, acc, table(val >> 1));
+                } else {
+                    std::copy_n(table(val >> 1).data(), k, acc.data());
+                    started = true;
+                }
+                i = l;
+            }
+
+            std::copy(acc.begin(), acc.end(), out.begin());
+        }
+
+        // Sliding window powering; `Normal` converts the result out of Montgomery form.
+        template <bool Normal>
+        inline static constexpr auto powm_sliding(
+            num_t out,
+            const_num_t const& base,
+            const_num_t const& exp,
+            MontgomeryContext const& ctx,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            using val_t = Integer::value_type;
+            assert(!exp.is_neg() && "negative exponents are not supported");
+            auto const k = ctx.size();
+            assert(out.size() >= k);
+
+            auto const e = exp.trim_trailing_zeros();
+            auto const bits = e.bits();
+            auto const w = powm_window_bits(bits);
+            auto const table_size = 1zu << (w - 1);
+
+            std::pmr::vector<val_t> buff((table_size + 2) * k + ctx.scratch_size(), 0, resource);
+            auto scratch = num_t(buff.data() + (table_size + 2) * k, ctx.scratch_size());
+            auto acc = num_t(buff.data(), k);
+            auto table = [&buff, k](std::size_t i) { return num_t(buff.data() + (i + 2) * k, k); };
+            std::pmr::vector<MontgomeryContext::acc_t> wide(ctx.wide_scratch_size(), 0, resource);
+
+            if (bits == 0) {
+                if constexpr (Normal) ctx.from_mont(out, ctx.one(), scratch);
+                else std::copy_n(ctx.one().data(), k, out.data());
+                return;
+            }
+
+            // table[i] = base^(2i + 1) in Montgomery form
+            auto g2 = num_t(buff.data() + k, k);
+            powm_reduce_base(acc.span(), base, ctx.modulus(), resource);
+            ctx.to_mont(table(0), acc, scratch, wide);
+            ctx.mont_sqr(g2, table(0), scratch);
+            for (auto i = 1zu; i < table_size; ++i) {
+                ctx.mont_mul(table(i), table(i - 1), g2, scratch, wide);
+            }
+
+            auto started = false;
+            auto i = bits;
+            while (i > 0) {
+                if (!get_integer_bit(e, i - 1)) {
+                    if (started) ctx.mont_sqr(acc, acc, scratch);
+                    --i;
+                    continue;
+                }
+
+                // longest window [l, i) that ends with a set bit
+                auto l = std::max(i, w) - w;
+                while (!get_integer_bit(e, l)) ++l;
+                auto const val = powm_exp_window(e, l, i - l);
+
+                if (started) {
+                    for (auto j = l; j < i; ++j) ctx.mont_sqr(acc, acc, scratch);
+                    ctx.mont_mul(acc, acc, table(val >> 1), scratch, wide);
+                } else {
+                    std::copy_n(table(val >> 1).data(), k, acc.data());
+                    started = true;
+                }
+                i = l;
+            }
+
+            if constexpr (Normal) ctx.from_mont(out, acc, scratch);
+            else std::copy_n(acc.data(), k, out.data());
+        }
+    } // namespace detail
+
+    /**
+     * out = base^exp mod m using Montgomery multiplication and a sliding window
+     * over the exponent. The window table holds the odd powers base^1, base^3, ...
+     * and its size grows with the exponent length.
+     * out needs ctx.size() blocks; the exponent has to be non-negative.
+    */
+    inline static constexpr auto powm(
+        num_t out,
+        const_num_t const& base,
+        const_num_t const& exp,
+        MontgomeryContext const& ctx,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        detail::powm_sliding<true>(out, base, exp, ctx, resource);
+    }
+
+    /**
+     * `powm` that leaves out = base^exp R mod m in Montgomery form, for callers
+     * that keep working with `ctx` and would convert the result straight back.
+    */
+    inline static constexpr auto powm_mont(
+        num_t out,
+        const_num_t const& base,
+        const_num_t const& exp,
+        MontgomeryContext const& ctx,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        detail::powm_sliding<false>(out, base, exp, ctx, resource);
+    }
+
+    /**
+     * Constant-time variant of `powm` for secret exponents.
+     * Uses a fixed window of `MachineConfig::powm_sec_window_bits` bits over the whole
+     * exponent span (its block count is treated as public) and reads the table by
+     * scanning every entry, so neither the sequence of operations nor the memory
+     * access pattern depends on the exponent bits.
+    */
+    inline static constexpr auto powm_sec(
+        num_t out,
+        const_num_t const& base,
+        const_num_t const& exp,
+        MontgomeryContext const& ctx,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        using val_t = Integer::value_type;
+        constexpr auto w = MachineConfig::powm_sec_window_bits;
+        constexpr auto table_size = 1zu << w;
+        assert(!exp.is_neg() && "negative exponents are not supported");
+        auto const k = ctx.size();
+        assert(out.size() >= k);
+
+        std::pmr::vector<val_t> buff((table_size + 2) * k + ctx.scratch_size(), 0, resource);
+        auto scratch = num_t(buff.data() + (table_size + 2) * k, ctx.scratch_size());
+        auto acc = num_t(buff.data(), k);
+        auto sel = num_t(buff.data() + k, k);
+        auto table = [&buff, k](std::size_t i) { return num_t(buff.data() + (i + 2) * k, k); };
+        std::pmr::vector<MontgomeryContext::acc_t> wide(ctx.wide_scratch_size(), 0, resource);
+
+        // table[i] = base^i in Montgomery form
+        std::copy_n(ctx.one().data(), k, table(0).data());
+        detail::powm_reduce_base(acc.span(), base, ctx.modulus(), resource);
+        ctx.to_mont(table(1), acc, scratch, wide);
+        for (auto i = 2zu; i < table_size; ++i) {
+            ctx.mont_mul(table(i), table(i - 1), table(1), scratch, wide);
+        }
+
+        auto const e = exp.span();
+        auto const bits = MachineConfig::next_multiple(e.size() * MachineConfig::bits, w);
+        std::copy_n(ctx.one().data(), k, acc.data());
+
+        for (auto i = bits; i > 0; i -= w) {
+            for (auto j = 0zu; j < w; ++j) ctx.mont_sqr(acc, acc, scratch);
+
+            auto const val = detail::powm_exp_window(e, i - w, w);
+            std::fill(sel.begin(), sel.end(), 0);
+            for (auto t = 0zu; t < table_size; ++t) {
+                // all ones iff t == val
+                auto const diff = static_cast<MachineConfig::acc_t>(t ^ val);
+                auto const mask = static_cast<val_t>(((diff - 1) >> (sizeof(diff) * 8 - 1)) * MachineConfig::mask);
+                auto const entry = table(t);
+                for (auto j = 0zu; j < k; ++j) sel[j] |= entry[j] & mask;
+            }
+            ctx.mont_mul(acc, acc, sel, scratch, wide);
+        }
+
+        ctx.from_mont(out, acc, scratch);
+    }
+
+    /**
+     * out = base^exp mod m in [0, m) for an arbitrary modulus; out needs `mod.size()`
+     * blocks and may alias any of the inputs, it is only written once the result is known.
+     * Odd moduli use Montgomery multiplication, even moduli fall back to Barrett reduction.
+     * @returns true if successful; otherwise false if the modulus is zero
+    */
+    inline static constexpr auto powm(
+        num_t out,
+        const_num_t const& base,
+        const_num_t const& exp,
+        const_num_t const& mod,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        auto const m = mod.trim_trailing_zeros();
+        if (m.empty()) return false;
+        if (m[0] & 1) {
+            auto ctx = MontgomeryContext(m, resource);
+            powm(out, base, exp, ctx, resource);
+        } else {
+            detail::powm_barrett(out, base, exp, m, resource);
+        }
+        std::fill(out.begin() + static_cast<std::ptrdiff_t>(m.size()), out.end(), 0);
+        return true;
+    }
+
+    /**
+     * @returns true if successful; otherwise false if the modulus is zero or even
+    */
+    inline static constexpr auto powm_sec(
+        num_t out,
+        const_num_t const& base,
+        const_num_t const& exp,
+        const_num_t const& mod,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        auto const m = mod.trim_trailing_zeros();
+        if (m.empty() || !(m[0] & 1)) return false;
+        auto ctx = MontgomeryContext(m, resource);
+        powm_sec(out, base, exp, ctx, resource);
+        std::fill(out.begin() + static_cast<std::ptrdiff_t>(m.size()), out.end(), 0);
+        return true;
+    }
+
+    /**
+     * The result is sized to the modulus instead of `pow_cal_size`.
+     * @returns true if successful; otherwise false if the modulus is zero
+    */
+    inline static constexpr auto powm(
+        Integer& out,
+        Integer const& base,
+        Integer const& exp,
+        Integer const& mod,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        if (mod.empty()) return false;
+        // out may be one of the inputs, so it is resized only after they are read
+        auto res = std::pmr::vector<Integer::value_type>(mod.size(), 0, resource);
+        powm(num_t(res.data(), res.size()), base.to_span(), exp.to_span(), mod.to_span(), resource);
+        out.resize(res.size() * MachineConfig::bits);
+        out.set_neg(false);
+        std::copy(res.begin(), res.end(), out.data());
+        out.remove_trailing_empty_blocks();
+        return true;
+    }
+
+    /**
+     * @returns true if successful; otherwise false if the modulus is zero or even
+    */
+    inline static constexpr auto powm_sec(
+        Integer& out,
+        Integer const& base,
+        Integer const& exp,
+        Integer const& mod,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        if (mod.empty() || !(mod.data()[0] & 1)) return false;
+        auto res = std::pmr::vector<Integer::value_type>(mod.size(), 0, resource);
+        powm_sec(num_t(res.data(), res.size()), base.to_span(), exp.to_span(), mod.to_span(), resource);
+        out.resize(res.size() * MachineConfig::bits);
+        out.set_neg(false);
+        std::copy(res.begin(), res.end(), out.data());
+        out.remove_trailing_empty_blocks();
+        return true;
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_MOD_POWM_HPP
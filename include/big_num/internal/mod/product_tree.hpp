@@ -0,0 +1,175 @@
+#ifndef AMT_BIG_NUM_INTERNAL_MOD_PRODUCT_TREE_HPP
+#define AMT_BIG_NUM_INTERNAL_MOD_PRODUCT_TREE_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include "../div/prepared.hpp"
+#include "../parallel.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace big_num::internal {
+
+    /**
+     * Binary tree of products over a list of moduli: level 0 holds |m_i|, every
+     * node above is the product of its two children and a node without a sibling
+     * is carried up unchanged, so the last level holds the product of all of them.
+     * Neighbouring nodes have about the same size, which keeps every product in
+     * the fast `mul` tiers. The nodes of one level are independent and are
+     * multiplied across `threads` (0 = all hardware threads), which all allocate
+     * from `resource`; it has to be thread-safe unless `threads` is 1.
+     *
+     * Every node also keeps a `PreparedDivisor`, so `remainder_tree` can walk back
+     * down reducing by each node without redoing the reciprocal work.
+     * The tree is immutable after construction and can be shared between threads.
+    */
+    struct ProductTree {
+        using value_type = Integer::value_type;
+        using size_type = std::size_t;
+
+        ProductTree(
+            std::span<Integer const> moduli,
+            std::size_t threads = 1,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        )
+            : m_nodes(resource)
+            , m_div(resource)
+        {
+            if (moduli.empty()) return;
+
+            m_nodes.emplace_back(moduli.size());
+            for (auto i = 0zu; i < moduli.size(); ++i) {
+                auto const v = moduli[i].to_span().trim_trailing_zeros().span();
+                assert(!v.empty() && "modulus cannot be zero");
+                m_nodes[0][i].assign(v.begin(), v.end());
+            }
+
+            while (m_nodes.back().size() > 1) {
+                auto const k = m_nodes.back().size();
+                m_nodes.emplace_back((k + 1) / 2);
+                auto const& lower = m_nodes[m_nodes.size() - 2];
+                auto& upper = m_nodes.back();
+                parallel_for(upper.size(), threads, [&](std::size_t b, std::size_t e) {
+                    for (auto j = b; j < e; ++j) {
+                        if (2 * j + 1 == k) {
+                            upper[j] = lower[2 * j];
+                        } else {
+                            detail::vec_mul(upper[j], lower[2 * j], lower[2 * j + 1], resource);
+                        }
+                    }
+                });
+            }
+
+            m_div.resize(m_nodes.size());
+            for (auto l = 0zu; l < m_nodes.size(); ++l) {
+                auto& divs = m_div[l];
+                divs.resize(m_nodes[l].size());
+                parallel_for(divs.size(), threads, [&](std::size_t b, std::size_t e) {
+                    for (auto i = b; i < e; ++i) {
+                        if (is_carried(l, i)) continue;
+                        auto const& v = m_nodes[l][i];
+                        divs[i].emplace(const_num_t(v.data(), v.size()), resource);
+                    }
+                });
+            }
+        }
+
+        // Number of moduli.
+        constexpr auto size() const noexcept -> size_type {
+            return m_nodes.empty() ? 0 : m_nodes[0].size();
+        }
+
+        constexpr auto levels() const noexcept -> size_type { return m_nodes.size(); }
+
+        constexpr auto node(size_type level, size_type i) const noexcept -> const_num_t {
+            auto const& v = m_nodes[level][i];
+            return { v.data(), v.size() };
+        }
+
+        // A node without a sibling is its own parent, so it is copied instead of multiplied or reduced.
+        constexpr auto is_carried(size_type level, size_type i) const noexcept -> bool {
+            auto const k = m_nodes[level].size();
+            return level + 1 < levels() && (k & 1) && i + 1 == k;
+        }
+
+        // Product of all the moduli; empty when there are none.
+        constexpr auto root() const noexcept -> const_num_t {
+            if (m_nodes.empty()) return {};
+            return node(levels() - 1, 0);
+        }
+
+        /**
+         * out[i] = |x| mod |m_i| with the sign of x.
+         * x is reduced by the root once, then every remainder is reduced by the two
+         * children of its node on the way down. A node's dividend is never more
+         * than twice its size, so each level costs about as much as multiplying
+         * it, and the nodes of a level are split across `threads`; `resource`
+         * is shared by them as in the constructor.
+         * out has to be at least as long as the moduli.
+        */
+        auto remainder_tree(
+            std::span<Integer> out,
+            Integer const& x,
+            std::size_t threads = 1,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        ) const -> void {
+            using val_t = Integer::value_type;
+            assert(out.size() >= size());
+            if (m_nodes.empty()) return;
+
+            auto cur = std::pmr::vector<detail::block_vec_t>(1, resource);
+            {
+                auto const& den = *m_div.back()[0];
+                auto scratch = std::pmr::vector<val_t>(den.scratch_size(x.size()), 0, resource);
+                cur[0].resize(den.size(), 0);
+                den.divmod(num_t{}, num_t(cur[0].data(), cur[0].size()), x.to_span(), std::span(scratch), resource);
+                detail::vec_trim(cur[0]);
+            }
+
+            auto next = std::pmr::vector<detail::block_vec_t>(resource);
+            for (auto l = levels() - 1; l > 0; --l) {
+                auto const level = l - 1;
+                auto const& divs = m_div[level];
+                next.resize(divs.size());
+                parallel_for(divs.size(), threads, [&](std::size_t b, std::size_t e) {
+                    auto scratch = std::pmr::vector<val_t>(resource);
+                    for (auto i = b; i < e; ++i) {
+                        auto const& parent = cur[i / 2];
+                        auto& r = next[i];
+                        if (is_carried(level, i)) {
+                            r = parent;
+                            continue;
+                        }
+                        auto const& den = *divs[i];
+                        scratch.resize(std::max(scratch.size(), den.scratch_size(parent.size())), 0);
+                        r.resize(den.size(), 0);
+                        den.divmod(
+                            num_t{},
+                            num_t(r.data(), r.size()),
+                            const_num_t(parent.data(), parent.size()),
+                            std::span(scratch),
+                            resource
+                        );
+                        detail::vec_trim(r);
+                    }
+                });
+                std::swap(cur, next);
+            }
+
+            for (auto i = 0zu; i < size(); ++i) {
+                detail::vec_to_integer(out[i], cur[i], x.is_neg());
+            }
+        }
+
+    private:
+        std::pmr::vector<std::pmr::vector<detail::block_vec_t>> m_nodes;
+        std::pmr::vector<std::pmr::vector<std::optional<PreparedDivisor>>> m_div;
+    };
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_MOD_PRODUCT_TREE_HPP
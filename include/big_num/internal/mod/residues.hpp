@@ -0,0 +1,180 @@
+#ifndef AMT_BIG_NUM_INTERNAL_MOD_RESIDUES_HPP
+#define AMT_BIG_NUM_INTERNAL_MOD_RESIDUES_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "ui.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace big_num::internal {
+
+    /**
+     * Powers B^j mod p_i for j in [0, chunk] and a list of block-sized moduli,
+     * stored row by row so that one row covers every modulus and the inner loops
+     * run lane-wise across the moduli.
+     * Building it once is enough for any number of `residues` calls.
+    */
+    struct ResidueTable {
+        using value_type = Integer::value_type;
+        using acc_t = MachineConfig::acc_t;
+        using size_type = std::size_t;
+
+        // Blocks folded per step. Every step costs two divisions per modulus, and
+        // `chunk` partial products of `bits` bits still fit the accumulator.
+        static constexpr size_type chunk = 8;
+
+        ResidueTable(
+            std::span<value_type const> moduli,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        )
+            : m_mod(moduli.begin(), moduli.end(), resource)
+            , m_pow((chunk + 1) * moduli.size(), 0, resource)
+        {
+            auto const np = moduli.size();
+            for (auto i = 0zu; i < np; ++i) {
+                auto const p = acc_t{moduli[i]};
+                assert(p > 0 && p <= MachineConfig::max && "modulus has to fit in a block");
+                auto const b = MachineConfig::max % p;
+                auto v = acc_t{1} % p;
+                for (auto j = 0zu; j <= chunk; ++j) {
+                    m_pow[j * np + i] = v;
+                    v = (v * b) % p;
+                }
+            }
+        }
+
+        constexpr auto size() const noexcept -> size_type { return m_mod.size(); }
+        constexpr auto moduli() const noexcept -> std::span<value_type const> { return m_mod; }
+
+        // B^j mod p_i for every modulus
+        constexpr auto powers(size_type j) const noexcept -> std::span<acc_t const> {
+            return std::span(m_pow.data() + j * size(), size());
+        }
+
+    private:
+        std::pmr::vector<value_type> m_mod;
+        std::pmr::vector<acc_t> m_pow;
+    };
+
+    /**
+     * out[i] = |num| mod p_i
+     * Walks the blocks of num once from the top, `ResidueTable::chunk` blocks at a
+     * time. For each chunk the products l_j * (B^j mod p_i) are split into their low
+     * and high `bits` and summed lane-wise across the moduli on `simd_acc_t`, so the
+     * number is streamed from memory a single time and the hardware divisions drop
+     * to two per chunk and modulus.
+     * out needs `table.size()` blocks.
+    */
+    inline static constexpr auto residues(
+        std::span<Integer::value_type> out,
+        const_num_t const& num,
+        ResidueTable const& table,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        using acc_t = MachineConfig::acc_t;
+        using val_t = Integer::value_type;
+        constexpr auto K = ResidueTable::chunk;
+        constexpr auto bits = MachineConfig::bits;
+        constexpr auto mask = MachineConfig::mask;
+
+        auto const np = table.size();
+        auto const mods = table.moduli();
+        assert(out.size() >= np);
+
+        auto const u = num.trim_trailing_zeros().span();
+        std::pmr::vector<acc_t> buff(3 * np, 0, resource);
+        auto r = std::span(buff.data(), np);
+        auto lo = std::span(buff.data() + np, np);
+        auto hi = std::span(buff.data() + 2 * np, np);
+
+        auto const b1 = table.powers(1);
+        auto const bk = table.powers(K);
+
+        acc_t limbs[K];
+        for (auto c = (u.size() + K - 1) / K; c > 0; --c) {
+            auto const base = (c - 1) * K;
+            for (auto j = 0zu; j < K; ++j) {
+                limbs[j] = base + j < u.size() ? acc_t{u[base + j]} : acc_t{};
+            }
+
+            std::fill(lo.begin(), lo.end(), 0);
+            std::fill(hi.begin(), hi.end(), 0);
+
+            for (auto j = 0zu; j < K; ++j) {
+                auto const l = limbs[j];
+                if (l == 0) continue;
+                auto const pw = table.powers(j);
+                auto i = 0zu;
+                if (!std::is_constant_evaluated()) {
+                    using simd_t = MachineConfig::simd_acc_t;
+                    static constexpr auto N = simd_t::elements;
+                    auto const vl = simd_t::load(l);
+                    auto const vmask = simd_t::load(mask);
+                    auto const sz = np - np % N;
+                    for (; i < sz; i += N) {
+                        auto const p = simd_t::load(pw.data() + i, N) * vl;
+                        auto vlo = simd_t::load(lo.data() + i, N) + (p & vmask);
+                        auto vhi = simd_t::load(hi.data() + i, N) + ui::shift_right<bits>(p);
+                        vlo.store(lo.data() + i, N);
+                        vhi.store(hi.data() + i, N);
+                    }
+                }
+                for (; i < np; ++i) {
+                    auto const p = pw[i] * l;
+                    lo[i] += p & mask;
+                    hi[i] += p >> bits;
+                }
+            }
+
+            // r = r * B^K + hi * B + lo
+            for (auto i = 0zu; i < np; ++i) {
+                auto const p = acc_t{mods[i]};
+                auto const t = (hi[i] % p) * b1[i] + lo[i] + r[i] * bk[i];
+                r[i] = t % p;
+            }
+        }
+
+        for (auto i = 0zu; i < np; ++i) {
+            out[i] = static_cast<val_t>(r[i]);
+        }
+    }
+
+    /**
+     * One-off variant that builds the power table for `moduli`; prefer keeping a
+     * `ResidueTable` around when the same moduli are used again.
+    */
+    inline static constexpr auto residues(
+        std::span<Integer::value_type> out,
+        const_num_t const& num,
+        std::span<Integer::value_type const> moduli,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto table = ResidueTable(moduli, resource);
+        residues(out, num, table, resource);
+    }
+
+    inline static constexpr auto residues(
+        std::span<Integer::value_type> out,
+        Integer const& num,
+        ResidueTable const& table,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        residues(out, num.to_span(), table, resource);
+    }
+
+    inline static constexpr auto residues(
+        std::span<Integer::value_type> out,
+        Integer const& num,
+        std::span<Integer::value_type const> moduli,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        residues(out, num.to_span(), moduli, resource);
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_MOD_RESIDUES_HPP
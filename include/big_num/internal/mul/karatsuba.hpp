@@ -51,7 +51,9 @@ namespace big_num::internal {
             auto const sz = size + 1;
             auto z0_buff = std::pmr::vector<uint_t>{sz, 0, resource};
             auto z2_buff = std::pmr::vector<uint_t>{sz, 0, resource};
-            auto z3_buff = std::pmr::vector<uint_t>{sz, 0, resource};
+            // (x_l + x_u) * (y_l + y_u) can carry past size + 1 blocks when the sums
+            // carry; truncating it would make z3 - z0 - z2 wrap at the wrong length.
+            auto z3_buff = std::pmr::vector<uint_t>{2 * sum_sz, 0, resource};
 
             auto z0 = NumberSpan(std::span(z0_buff));
             auto z2 = NumberSpan(std::span(z2_buff));
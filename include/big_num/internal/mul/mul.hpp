@@ -6,6 +6,9 @@
 #include "toom_cook.hpp"
 #include "karatsuba.hpp"
 #include "naive.hpp"
+#include <algorithm>
+#include <memory_resource>
+#include <vector>
 
 namespace big_num::internal {
 
@@ -65,6 +68,40 @@ namespace big_num::internal {
         }
     }
 
+    /**
+     * Product of operands with very different sizes. The larger one is cut into
+     * chunks of the smaller one's size, so every partial product is balanced
+     * instead of padding the small operand up to the large one.
+     * out has to be zero filled and hold `lhs.size() + rhs.size()` blocks.
+    */
+    inline static constexpr auto mul_unbalanced(
+        NumberSpan<Integer::value_type> out,
+        NumberSpan<Integer::value_type const> const& lhs,
+        NumberSpan<Integer::value_type const> const& rhs,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto const& big = lhs.size() >= rhs.size() ? lhs : rhs;
+        auto const& small = lhs.size() >= rhs.size() ? rhs : lhs;
+        auto const k = small.size();
+        if (k == 0) return;
+        if (2 * k >= big.size()) {
+            mul(out, lhs, rhs, resource);
+            return;
+        }
+
+        std::pmr::vector<Integer::value_type> tmp(2 * k, 0, resource);
+        for (auto off = 0zu; off < big.size(); off += k) {
+            auto const len = std::min(k, big.size() - off);
+            std::fill(tmp.begin(), tmp.end(), 0);
+            auto t = NumberSpan<Integer::value_type>(tmp.data(), len + k);
+            mul(t, NumberSpan<Integer::value_type const>(big.data() + off, len), small, resource);
+            abs_add(
+                NumberSpan<Integer::value_type>(out.data() + off, out.size() - off),
+                NumberSpan<Integer::value_type const>(t.data(), t.size())
+            );
+        }
+    }
+
     inline static constexpr auto square(
         NumberSpan<Integer::value_type> out,
         NumberSpan<Integer::value_type const> const& a,
@@ -147,11 +147,15 @@ namespace big_num::internal {
             auto s0 = std::max(l_0.size(), r_0.size());
             auto s1 = std::max(l_1.size(), r_1.size());
             auto sinf = std::max(l_inf.size(), r_inf.size());
-            auto o_n2_buf = int_t{sn2 * 2 + 1, 0, resource};
-            auto o_n1_buf = int_t{sn1 * 2 + 1, 0, resource};
-            auto o_0_buf = int_t{s0 * 2 + 1, 0, resource};
-            auto o_1_buf = int_t{s1 * 2 + 1, 0, resource};
-            auto o_inf_buf = int_t{sinf * 2 + 1, 0, resource};
+            // The interpolation below subtracts the point products from each other
+            // in place, so every buffer has to hold the largest of them; sizing each
+            // one by its own product truncated the differences.
+            auto const so = std::max({ sn2, sn1, s0, s1, sinf }) * 2 + 1;
+            auto o_n2_buf = int_t{so, 0, resource};
+            auto o_n1_buf = int_t{so, 0, resource};
+            auto o_0_buf = int_t{so, 0, resource};
+            auto o_1_buf = int_t{so, 0, resource};
+            auto o_inf_buf = int_t{so, 0, resource};
 
             auto o_n2 =  NumberSpan(std::span(o_n2_buf));
             auto o_n1 =  NumberSpan(std::span(o_n1_buf));
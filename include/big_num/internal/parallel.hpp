@@ -0,0 +1,45 @@
+#ifndef AMT_BIG_NUM_INTERNAL_PARALLEL_HPP
+#define AMT_BIG_NUM_INTERNAL_PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace big_num::internal {
+
+    inline static auto hardware_threads() noexcept -> std::size_t {
+        return std::max(1zu, static_cast<std::size_t>(std::thread::hardware_concurrency()));
+    }
+
+    /**
+     * Splits [0, n) into at most `threads` contiguous chunks and calls fn(begin, end)
+     * for each of them; the calling thread works on the first chunk.
+     * `threads == 0` uses every hardware thread.
+    */
+    template <typename Fn>
+    inline static auto parallel_for(
+        std::size_t n,
+        std::size_t threads,
+        Fn&& fn
+    ) -> void {
+        if (threads == 0) threads = hardware_threads();
+        threads = std::min(threads, n);
+        if (threads <= 1) {
+            if (n) fn(0zu, n);
+            return;
+        }
+
+        auto const chunk = (n + threads - 1) / threads;
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (auto b = chunk; b < n; b += chunk) {
+            auto const e = std::min(n, b + chunk);
+            workers.emplace_back([&fn, b, e] { fn(b, e); });
+        }
+        fn(0zu, std::min(n, chunk));
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_PARALLEL_HPP
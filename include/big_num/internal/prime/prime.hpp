@@ -0,0 +1,398 @@
+#ifndef AMT_BIG_NUM_INTERNAL_PRIME_PRIME_HPP
+#define AMT_BIG_NUM_INTERNAL_PRIME_PRIME_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../cmp.hpp"
+#include "../add_sub.hpp"
+#include "../logical_bitwise.hpp"
+#include "../block_vec.hpp"
+#include "../parallel.hpp"
+#include "../div/mod.hpp"
+#include "../mod/montgomery.hpp"
+#include "../mod/powm.hpp"
+#include "../root/sqrt.hpp"
+#include "trial.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace big_num::internal {
+    namespace detail {
+        // Jacobi symbol (a / n) for odd n > 0.
+        inline static constexpr auto jacobi_word(
+            MachineConfig::acc_t a,
+            MachineConfig::acc_t n
+        ) noexcept -> int {
+            assert(n & 1);
+            a %= n;
+            auto r = 1;
+            while (a != 0) {
+                while (!(a & 1)) {
+                    a >>= 1;
+                    auto const m = n & 7;
+                    if (m == 3 || m == 5) r = -r;
+                }
+                std::swap(a, n);
+                if ((a & 3) == 3 && (n & 3) == 3) r = -r;
+                a %= n;
+            }
+            return n == 1 ? r : 0;
+        }
+
+        /**
+         * Residue arithmetic on k-block values in [0, m) for the Lucas sequences;
+         * the values stay in Montgomery form, which addition, subtraction and
+         * halving do not care about.
+        */
+        struct PrimeField {
+            MontgomeryContext ctx;
+            std::pmr::vector<Integer::value_type> scratch;
+            std::pmr::vector<MontgomeryContext::acc_t> wide;
+
+            PrimeField(const_num_t const& m, std::pmr::memory_resource* resource)
+                : ctx(m, resource)
+                , scratch(ctx.scratch_size(), 0, resource)
+                , wide(ctx.wide_scratch_size(), 0, resource)
+            {}
+
+            constexpr auto size() const noexcept -> std::size_t { return ctx.size(); }
+
+            constexpr auto mul(num_t out, const_num_t const& a, const_num_t const& b) -> void {
+                ctx.mont_mul(out, a, b, std::span(scratch), std::span(wide));
+            }
+
+            constexpr auto sqr(num_t out, const_num_t const& a) -> void {
+                ctx.mont_sqr(out, a, std::span(scratch));
+            }
+
+            // a = a + b mod m
+            constexpr auto add(num_t a, const_num_t const& b) const -> void {
+                auto const m = ctx.modulus();
+                auto const c = abs_add(a, b);
+                if (c || abs_compare(a.span(), m.span()) != std::strong_ordering::less) {
+                    abs_sub(a, m);
+                }
+            }
+
+            // a = a - b mod m
+            constexpr auto sub(num_t a, const_num_t const& b) const -> void {
+                if (abs_sub(a, b)) abs_add(a, ctx.modulus());
+            }
+
+            // a = a / 2 mod m
+            constexpr auto half(num_t a) const -> void {
+                auto c = Integer::value_type{};
+                if (a[0] & 1) c = abs_add(a, ctx.modulus());
+                shift_right(a.span(), a.span(), 1);
+                a[a.size() - 1] |= static_cast<Integer::value_type>(c << (MachineConfig::bits - 1));
+            }
+
+            // Montgomery form of a small signed value
+            constexpr auto from_small(num_t out, MachineConfig::iacc_t v) -> void {
+                auto mag = static_cast<MachineConfig::acc_t>(v < 0 ? -v : v);
+                auto const k = size();
+                // D and Q can reach past a modulus of a block or two; to_mont wants |v| < m
+                if (k <= 2) mag %= vec_get(ctx.modulus().span());
+                std::fill(out.begin(), out.end(), 0);
+                out[0] = static_cast<Integer::value_type>(mag & MachineConfig::mask);
+                if (k > 1) out[1] = static_cast<Integer::value_type>(mag >> MachineConfig::bits);
+                ctx.to_mont(out, out, std::span(scratch), std::span(wide));
+                if (v < 0 && !is_zero(out)) {
+                    // m - out, in place
+                    auto const m = ctx.modulus();
+                    auto borrow = MachineConfig::acc_t{};
+                    for (auto i = 0zu; i < k; ++i) {
+                        auto const d = MachineConfig::acc_t{m[i]} - out[i] - borrow;
+                        out[i] = static_cast<Integer::value_type>(d & MachineConfig::mask);
+                        borrow = (d >> MachineConfig::bits) & 1;
+                    }
+                }
+            }
+
+            static constexpr auto is_zero(const_num_t const& a) noexcept -> bool {
+                return std::all_of(a.begin(), a.end(), [](auto v) { return v == 0; });
+            }
+
+            constexpr auto equal(const_num_t const& a, const_num_t const& b) const noexcept -> bool {
+                return std::equal(a.begin(), a.end(), b.begin());
+            }
+        };
+
+        /**
+         * Strong probable prime test to the base `base` for an odd n > 3.
+        */
+        inline static auto miller_rabin(
+            PrimeField& f,
+            const_num_t const& base,
+            std::pmr::memory_resource* resource
+        ) -> bool {
+            using val_t = Integer::value_type;
+            auto const n = f.ctx.modulus();
+            auto const k = f.size();
+
+            // n - 1 = d * 2^s
+            auto nm1 = block_vec_t(n.begin(), n.end(), resource);
+            vec_sub(nm1, val_t{1});
+            auto s = 0zu;
+            while (nm1[s / MachineConfig::bits] == 0) s += MachineConfig::bits;
+            s += static_cast<std::size_t>(std::countr_zero(nm1[s / MachineConfig::bits]));
+            auto d = block_vec_t(resource);
+            vec_shift_right(d, nm1, s);
+
+            std::pmr::vector<val_t> buff(3 * k, 0, resource);
+            auto x = num_t(buff.data(), k);
+            auto one = num_t(buff.data() + k, k);
+            auto minus_one = num_t(buff.data() + 2 * k, k);
+            // x stays in Montgomery form, like one and minus_one below
+            powm_mont(x, base, const_num_t(d.data(), d.size()), f.ctx, resource);
+            std::copy_n(f.ctx.one().data(), k, one.data());
+            std::copy_n(n.data(), k, minus_one.data());
+            abs_sub(minus_one, one);
+
+            if (f.equal(x, one) || f.equal(x, minus_one)) return true;
+            for (auto i = 1zu; i < s; ++i) {
+                f.sqr(x, x);
+                if (f.equal(x, minus_one)) return true;
+                if (f.equal(x, one)) return false;
+            }
+            return false;
+        }
+
+        /**
+         * Strong Lucas probable prime test with Selfridge's parameters: the first D
+         * in 5, -7, 9, -11, ... with (D / n) = -1, P = 1 and Q = (1 - D) / 4.
+         * n is odd, not a perfect square and has no factor below the trial bound.
+        */
+        inline static auto strong_lucas(
+            PrimeField& f,
+            std::pmr::memory_resource* resource
+        ) -> bool {
+            using val_t = Integer::value_type;
+            using iacc_t = MachineConfig::iacc_t;
+            auto const n = f.ctx.modulus();
+            auto const k = f.size();
+
+            auto dd = iacc_t{5};
+            while (true) {
+                auto const ad = static_cast<MachineConfig::acc_t>(dd < 0 ? -dd : dd);
+                // D = 1 mod 4, so (D / n) = (n / |D|)
+                auto const j = jacobi_word(mod_1(n, static_cast<val_t>(ad)), ad);
+                if (j == -1) break;
+                // a common factor, unless n is |D| itself
+                if (j == 0 && !(n.size() <= 2 && vec_get(n.span()) == ad)) return false;
+                dd = dd < 0 ? -dd + 2 : -(dd + 2);
+            }
+            auto const q = (1 - dd) / 4;
+
+            // n + 1 = d * 2^s
+            std::pmr::vector<val_t> buff(7 * k + 1, 0, resource);
+            auto d = num_t(buff.data(), k + 1);
+            auto u = num_t(buff.data() + k + 1, k);
+            auto v = num_t(buff.data() + 2 * k + 1, k);
+            auto qk = num_t(buff.data() + 3 * k + 1, k);
+            auto t = num_t(buff.data() + 4 * k + 1, k);
+            auto md = num_t(buff.data() + 5 * k + 1, k);
+            auto mq = num_t(buff.data() + 6 * k + 1, k);
+            std::copy(n.begin(), n.end(), d.begin());
+            abs_add(d, val_t{1});
+            auto s = 0zu;
+            while (!get_integer_bit(d, s)) ++s;
+            auto const bits = d.trim_trailing_zeros().bits();
+
+            f.from_small(md, dd);
+            f.from_small(mq, q);
+
+            // U_1 = 1, V_1 = P = 1, Q^1
+            std::copy_n(f.ctx.one().data(), k, u.data());
+            std::copy_n(f.ctx.one().data(), k, v.data());
+            std::copy_n(mq.data(), k, qk.data());
+
+            for (auto i = bits - 1; i > s; --i) {
+                // U_2j = U_j V_j, V_2j = V_j^2 - 2 Q^j
+                f.mul(u, u, v);
+                f.sqr(v, v);
+                f.sub(v, qk);
+                f.sub(v, qk);
+                f.sqr(qk, qk);
+                if (get_integer_bit(d, i - 1)) {
+                    // U_(j + 1) = (U_j + V_j) / 2, V_(j + 1) = (D U_j + V_j) / 2
+                    f.mul(t, md, u);
+                    f.add(u, v);
+                    f.half(u);
+                    f.add(v, t);
+                    f.half(v);
+                    f.mul(qk, qk, mq);
+                }
+            }
+
+            if (PrimeField::is_zero(u) || PrimeField::is_zero(v)) return true;
+            for (auto r = 1zu; r < s; ++r) {
+                // V_2j = V_j^2 - 2 Q^j
+                f.sqr(v, v);
+                f.sub(v, qk);
+                f.sub(v, qk);
+                if (PrimeField::is_zero(v)) return true;
+                f.sqr(qk, qk);
+            }
+            return false;
+        }
+
+        // Deterministic bases for the extra Miller-Rabin rounds.
+        inline static constexpr auto prime_round_base(std::size_t i) noexcept -> MachineConfig::acc_t {
+            auto z = static_cast<MachineConfig::acc_t>(i + 1) * 0x9e3779b97f4a7c15ull;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+            return z ^ (z >> 31);
+        }
+
+        /**
+         * Baillie-PSW on an odd n without small factors, followed by `rounds`
+         * Miller-Rabin rounds with pseudo-random bases.
+        */
+        inline static auto bpsw(
+            const_num_t const& n,
+            std::size_t rounds,
+            std::pmr::memory_resource* resource
+        ) -> bool {
+            using val_t = Integer::value_type;
+            using acc_t = MachineConfig::acc_t;
+            auto f = PrimeField(n, resource);
+
+            val_t two[1] = { 2 };
+            if (!miller_rabin(f, const_num_t(two, 1), resource)) return false;
+
+            // perfect squares never give (D / n) = -1
+            {
+                auto const k = n.size();
+                std::pmr::vector<val_t> sr((k + 1) / 2 + k / 2 + 1, 0, resource);
+                if (isqrt_rem(
+                    num_t(sr.data(), (k + 1) / 2),
+                    num_t(sr.data() + (k + 1) / 2, k / 2 + 1),
+                    n,
+                    resource
+                )) return false;
+            }
+
+            if (!strong_lucas(f, resource)) return false;
+
+            // bases in [2, n - 2]
+            auto const small = n.size() <= 2 ? detail::vec_get(n.span()) : acc_t{};
+            for (auto i = 0zu; i < rounds; ++i) {
+                auto b = 2 + (prime_round_base(i) >> 3);
+                if (n.size() <= 2) b = 2 + prime_round_base(i) % (small - 3);
+                val_t w[2] = {
+                    static_cast<val_t>(b & MachineConfig::mask),
+                    static_cast<val_t>(b >> MachineConfig::bits)
+                };
+                if (!miller_rabin(f, const_num_t(w, 2), resource)) return false;
+            }
+            return true;
+        }
+    } // namespace detail
+
+    /**
+     * Probable prime test. Candidates are first checked against the primes of
+     * `table` with one multi-block `mod` by their product; survivors run a
+     * Baillie-PSW test (a base-2 Miller-Rabin with Montgomery `powm` and a strong
+     * Lucas test), then `rounds` more Miller-Rabin rounds.
+     * No composite passing Baillie-PSW is known; numbers below `table.bound()^2`
+     * are decided by trial division alone.
+     * @returns true if a is prime or a probable prime; false for composites and
+     *          for values below 2
+    */
+    inline static auto is_probable_prime(
+        const_num_t const& a,
+        std::size_t rounds,
+        TrialDivisionTable const& table,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        using acc_t = MachineConfig::acc_t;
+        if (a.is_neg()) return false;
+        auto const n = a.trim_trailing_zeros();
+        if (n.empty()) return false;
+
+        auto const small = n.size() <= 2 ? detail::vec_get(n.span()) : ~acc_t{};
+        if (small < 2) return false;
+        if (!(n[0] & 1)) return small == 2;
+
+        if (auto const p = table.find_factor(n, resource); p != 0) return small == p;
+        if (small < acc_t{table.bound()} * table.bound()) return true;
+
+        return detail::bpsw(n, rounds, resource);
+    }
+
+    inline static auto is_probable_prime(
+        const_num_t const& a,
+        std::size_t rounds = 0,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        return is_probable_prime(a, rounds, default_trial_division_table(), resource);
+    }
+
+    inline static auto is_probable_prime(
+        Integer const& a,
+        std::size_t rounds = 0,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        return is_probable_prime(a.to_span(), rounds, default_trial_division_table(), resource);
+    }
+
+    /**
+     * out[i] = is_probable_prime(start + i) as 0 or 1 for the interval
+     * [start, start + out.size()). One byte per entry, so any contiguous buffer
+     * (unlike `std::vector<bool>`) can hold the flags.
+     * The interval is sieved once with `sieve_interval`, so only the survivors pay
+     * for a Baillie-PSW test; those are split across `threads` (0 = all hardware
+     * threads).
+    */
+    inline static auto probable_primes_in(
+        std::span<std::uint8_t> out,
+        const_num_t const& start,
+        std::size_t rounds,
+        TrialDivisionTable const& table,
+        std::size_t threads = 1,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        using val_t = Integer::value_type;
+        using acc_t = MachineConfig::acc_t;
+        sieve_interval(out, start, table, resource);
+
+        auto const s = start.trim_trailing_zeros();
+        auto const bound = acc_t{table.bound()} * table.bound();
+        parallel_for(out.size(), threads, [&](std::size_t b, std::size_t e) {
+            std::pmr::vector<val_t> c(s.size() + 3, 0, resource);
+            for (auto i = b; i < e; ++i) {
+                if (!out[i]) continue;
+                std::fill(c.begin(), c.end(), 0);
+                std::copy(s.begin(), s.end(), c.begin());
+                auto w = std::array<val_t, 2>{
+                    static_cast<val_t>(i & MachineConfig::mask),
+                    static_cast<val_t>(i >> MachineConfig::bits)
+                };
+                abs_add(num_t(c.data(), c.size()), const_num_t(w.data(), w.size()));
+                auto const n = const_num_t(c.data(), c.size()).trim_trailing_zeros();
+                if (n.size() <= 2 && detail::vec_get(n.span()) < bound) continue;
+                out[i] = detail::bpsw(n, rounds, resource) ? 1 : 0;
+            }
+        });
+    }
+
+    inline static auto probable_primes_in(
+        std::span<std::uint8_t> out,
+        Integer const& start,
+        std::size_t rounds = 0,
+        std::size_t threads = 1,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        probable_primes_in(out, start.to_span(), rounds, default_trial_division_table(), threads, resource);
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_PRIME_PRIME_HPP
@@ -0,0 +1,66 @@
+#ifndef AMT_BIG_NUM_INTERNAL_PRIME_SIEVE_HPP
+#define AMT_BIG_NUM_INTERNAL_PRIME_SIEVE_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include <algorithm>
+#include <cassert>
+#include <memory_resource>
+#include <vector>
+
+namespace big_num::internal {
+
+    /**
+     * Appends every prime p <= n to out in increasing order; n has to fit in a block.
+     * Segmented sieve of Eratosthenes over the odd numbers: the primes up to
+     * sqrt(n) are found first and then strike out one cache-sized segment at a
+     * time, so memory stays at O(sqrt(n)) besides the output.
+    */
+    inline static auto primes_up_to(
+        std::pmr::vector<Integer::value_type>& out,
+        std::size_t n,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        using val_t = Integer::value_type;
+        // odd numbers per segment
+        constexpr auto segment = std::size_t{1} << 15;
+        assert(n <= MachineConfig::mask && "primes_up_to: bound does not fit in a block");
+        if (n < 2) return;
+        out.push_back(2);
+
+        auto root = 1zu;
+        while ((root + 1) * (root + 1) <= n) ++root;
+
+        // odd base primes up to sqrt(n)
+        std::pmr::vector<bool> small_sieve(root / 2 + 1, false, resource);
+        std::pmr::vector<std::size_t> base(resource);
+        for (auto i = 1zu; 2 * i + 1 <= root; ++i) {
+            if (small_sieve[i]) continue;
+            auto const p = 2 * i + 1;
+            base.push_back(p);
+            for (auto j = p * p / 2; j < small_sieve.size(); j += p) small_sieve[j] = true;
+        }
+
+        // index i stands for 2i + 1; next[j] is the next index struck by base[j]
+        std::pmr::vector<std::size_t> next(resource);
+        next.reserve(base.size());
+        for (auto p : base) next.push_back(p * p / 2);
+
+        std::pmr::vector<bool> seg(segment, false, resource);
+        auto const last = (n - 1) / 2;
+        for (auto lo = 1zu; lo <= last; lo += segment) {
+            auto const hi = std::min(last + 1, lo + segment);
+            std::fill(seg.begin(), seg.end(), false);
+            for (auto j = 0zu; j < base.size(); ++j) {
+                auto i = next[j];
+                for (; i < hi; i += base[j]) seg[i - lo] = true;
+                next[j] = i;
+            }
+            for (auto i = lo; i < hi; ++i) {
+                if (!seg[i - lo]) out.push_back(static_cast<val_t>(2 * i + 1));
+            }
+        }
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_PRIME_SIEVE_HPP
@@ -0,0 +1,186 @@
+#ifndef AMT_BIG_NUM_INTERNAL_PRIME_TRIAL_HPP
+#define AMT_BIG_NUM_INTERNAL_PRIME_TRIAL_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include "../div/mod.hpp"
+#include "../mod/residues.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace big_num::internal {
+
+    /**
+     * Odd primes below a bound, packed into groups whose products fit in a block,
+     * together with the product of all of them.
+     * A candidate is first reduced modulo the full product with one multi-block
+     * `mod`, the remainder is reduced modulo every group product in one pass of
+     * `residues`, and only the group residues are split per prime with word
+     * divisions.
+    */
+    struct TrialDivisionTable {
+        using value_type = Integer::value_type;
+        using acc_t = MachineConfig::acc_t;
+        using size_type = std::size_t;
+
+        TrialDivisionTable(
+            size_type bound = MachineConfig::prime_trial_bound,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        )
+            : m_primes(resource)
+            , m_groups(resource)
+            , m_group_end(resource)
+            , m_product(resource)
+            , m_table(std::span<value_type const>{}, resource)
+            , m_bound(std::max(bound, 3zu))
+        {
+            assert(m_bound <= MachineConfig::max && "primes have to fit in a block");
+
+            // sieve of Eratosthenes over the odd numbers
+            std::pmr::vector<bool> composite(m_bound / 2, false, resource);
+            for (auto i = 1zu; i < composite.size(); ++i) {
+                if (composite[i]) continue;
+                auto const p = 2 * i + 1;
+                m_primes.push_back(static_cast<value_type>(p));
+                for (auto j = p * p / 2; j < composite.size(); j += p) composite[j] = true;
+            }
+
+            auto g = acc_t{1};
+            for (auto i = 0zu; i < m_primes.size(); ++i) {
+                auto const p = acc_t{m_primes[i]};
+                if (g * p > MachineConfig::max) {
+                    m_groups.push_back(static_cast<value_type>(g));
+                    m_group_end.push_back(i);
+                    g = 1;
+                }
+                g *= p;
+            }
+            if (g != 1) {
+                m_groups.push_back(static_cast<value_type>(g));
+                m_group_end.push_back(m_primes.size());
+            }
+
+            auto t = detail::block_vec_t(resource);
+            detail::vec_set(m_product, 1);
+            for (auto v : m_groups) {
+                detail::vec_mul(t, m_product, std::span(&v, 1), resource);
+                std::swap(t, m_product);
+            }
+
+            m_table = ResidueTable(m_groups, resource);
+        }
+
+        // Every prime in the table is below this.
+        constexpr auto bound() const noexcept -> size_type { return m_bound; }
+        constexpr auto primes() const noexcept -> std::span<value_type const> { return m_primes; }
+        constexpr auto product() const noexcept -> const_num_t { return { m_product.data(), m_product.size() }; }
+
+        /**
+         * out[i] = |num| mod primes()[i]; out needs `primes().size()` blocks.
+        */
+        auto residues(
+            std::span<value_type> out,
+            const_num_t const& num,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        ) const -> void {
+            assert(out.size() >= m_primes.size());
+            auto const n = num.abs().trim_trailing_zeros();
+            std::pmr::vector<value_type> buff(m_product.size() + m_groups.size(), 0, resource);
+            auto r = num_t(buff.data(), m_product.size());
+            auto gr = std::span(buff.data() + m_product.size(), m_groups.size());
+
+            auto red = n;
+            if (n.size() > m_product.size()) {
+                mod(r, n, product(), resource);
+                red = const_num_t(r.data(), r.size());
+            }
+            internal::residues(gr, red, m_table, resource);
+
+            auto b = 0zu;
+            for (auto g = 0zu; g < m_groups.size(); ++g) {
+                for (auto i = b; i < m_group_end[g]; ++i) out[i] = gr[g] % m_primes[i];
+                b = m_group_end[g];
+            }
+        }
+
+        /**
+         * @returns the smallest prime of the table that divides |num|, or zero if
+         *          there is none
+        */
+        auto find_factor(
+            const_num_t const& num,
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+        ) const -> value_type {
+            std::pmr::vector<value_type> r(m_primes.size(), 0, resource);
+            residues(r, num, resource);
+            for (auto i = 0zu; i < r.size(); ++i) {
+                if (r[i] == 0) return m_primes[i];
+            }
+            return 0;
+        }
+
+    private:
+        std::pmr::vector<value_type> m_primes;
+        std::pmr::vector<value_type> m_groups;
+        std::pmr::vector<size_type> m_group_end;
+        detail::block_vec_t m_product;
+        ResidueTable m_table;
+        size_type m_bound;
+    };
+
+    /**
+     * Table for the default bound, built on first use and shared afterwards.
+    */
+    inline static auto default_trial_division_table() -> TrialDivisionTable const& {
+        static auto const table = TrialDivisionTable();
+        return table;
+    }
+
+    /**
+     * Sets out[i] = 0 for every start + i in [start, start + out.size()) that is
+     * below two or has a prime factor below `table.bound()` other than itself; the
+     * remaining entries are set to 1.
+     * start is reduced once per prime and the multiples are then struck out over
+     * the whole interval, like a segment of a sieve of Eratosthenes.
+    */
+    inline static auto sieve_interval(
+        std::span<std::uint8_t> out,
+        const_num_t const& start,
+        TrialDivisionTable const& table,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        using acc_t = MachineConfig::acc_t;
+        assert(!start.is_neg() && "sieve_interval: negative start");
+        auto const s = start.trim_trailing_zeros();
+        auto const n = out.size();
+        std::fill(out.begin(), out.end(), std::uint8_t{1});
+        if (n == 0) return;
+
+        // start + i == v, only possible while start is below the table bound
+        auto const small = s.size() <= 2 ? detail::vec_get(s) : acc_t{};
+        auto const is_small = s.size() <= 2 && small < table.bound();
+        auto is = [&](std::size_t i, acc_t v) { return is_small && small + i == v; };
+
+        for (auto i = 0zu; i < n && is_small && small + i < 2; ++i) out[i] = 0;
+        for (auto i = (!s.empty() && (s[0] & 1)) ? 1zu : 0zu; i < n; i += 2) {
+            if (!is(i, 2)) out[i] = 0;
+        }
+
+        auto const primes = table.primes();
+        std::pmr::vector<Integer::value_type> r(primes.size(), 0, resource);
+        table.residues(r, s, resource);
+        for (auto j = 0zu; j < primes.size(); ++j) {
+            auto const p = acc_t{primes[j]};
+            for (auto i = (p - r[j]) % p; i < n; i += p) {
+                if (!is(i, p)) out[i] = 0;
+            }
+        }
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_PRIME_TRIAL_HPP
@@ -0,0 +1,248 @@
+#ifndef AMT_BIG_NUM_INTERNAL_RADIX_POWERS_HPP
+#define AMT_BIG_NUM_INTERNAL_RADIX_POWERS_HPP
+
+#include "integer.hpp"
+#include "base.hpp"
+#include "block_vec.hpp"
+#include "div/prepared.hpp"
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace big_num::internal {
+    namespace detail {
+        // Largest d with radix^d still fitting in a block.
+        inline static constexpr auto radix_chunk_digits(std::size_t radix) noexcept -> std::size_t {
+            auto d = 0zu;
+            for (auto p = MachineConfig::acc_t{radix}; p <= MachineConfig::mask; p *= radix) ++d;
+            return d;
+        }
+
+        // radix^radix_chunk_digits(radix)
+        inline static constexpr auto radix_chunk(std::size_t radix) noexcept -> Integer::value_type {
+            auto p = MachineConfig::acc_t{1};
+            for (auto i = radix_chunk_digits(radix); i > 0; --i) p *= radix;
+            return static_cast<Integer::value_type>(p);
+        }
+
+        // Blocks enough for any number with `digits` digits in the radix.
+        inline static constexpr auto radix_digits_blocks(std::size_t radix, std::size_t digits) noexcept -> std::size_t {
+            auto const bits = digits * static_cast<std::size_t>(std::bit_width(radix - 1));
+            return (bits + MachineConfig::bits - 1) / MachineConfig::bits + 1;
+        }
+
+        /**
+         * R^digits with its prepared divisor. Parsing only multiplies by the power,
+         * so the divisor is built the first time a conversion to a string asks
+         * for it; that is safe to race on.
+        */
+        struct RadixPower {
+            RadixPower(block_vec_t&& power, std::size_t digits)
+                : m_power(std::move(power))
+                , m_digits(digits)
+            {}
+
+            RadixPower(RadixPower const&) = delete;
+            RadixPower& operator=(RadixPower const&) = delete;
+
+            auto power() const noexcept -> std::span<Integer::value_type const> { return m_power; }
+            auto digits() const noexcept -> std::size_t { return m_digits; }
+
+            auto divisor() const -> PreparedDivisor const& {
+                std::call_once(m_once, [this] {
+                    m_div.emplace(const_num_t(m_power.data(), m_power.size()), m_power.get_allocator().resource());
+                });
+                return *m_div;
+            }
+
+        private:
+            block_vec_t m_power;
+            std::size_t m_digits;
+            mutable std::once_flag m_once;
+            mutable std::optional<PreparedDivisor> m_div;
+        };
+
+        /**
+         * Process-wide powers R^(d 2^k), k = 0, 1, ..., of one radix, where R^d is the
+         * largest power of the radix that fits in a block. Each entry is the square
+         * of the previous one and is never changed or dropped once published, so
+         * readers only need the published count; growing takes a lock.
+         * Growth stops once the powers would hold more than
+         * `MachineConfig::radix_cache_blocks` blocks in total.
+        */
+        struct RadixPowerCache {
+            static constexpr std::size_t max_entries = 64;
+
+            explicit RadixPowerCache(std::size_t radix)
+                : m_resource(std::pmr::new_delete_resource())
+            {
+                assert(radix > 1 && radix <= MachineConfig::mask);
+                auto p = block_vec_t(m_resource);
+                vec_set(p, radix_chunk(radix));
+                m_blocks = p.size();
+                m_entries[0] = std::make_unique<RadixPower>(std::move(p), radix_chunk_digits(radix));
+                m_size.store(1, std::memory_order_release);
+            }
+
+            auto size() const noexcept -> std::size_t { return m_size.load(std::memory_order_acquire); }
+
+            auto operator[](std::size_t k) const noexcept -> RadixPower const& {
+                assert(k < size());
+                return *m_entries[k];
+            }
+
+            /**
+             * Publishes entries up to k if the bound allows.
+             * @returns the number of published entries, which may be below k + 1
+            */
+            auto ensure(std::size_t k) -> std::size_t {
+                auto n = size();
+                if (n > k) return n;
+
+                auto lock = std::lock_guard(m_mutex);
+                n = m_size.load(std::memory_order_relaxed);
+                while (n <= k && n < max_entries) {
+                    auto const& last = *m_entries[n - 1];
+                    if (m_blocks + 2 * last.power().size() > MachineConfig::radix_cache_blocks) break;
+                    auto p = block_vec_t(m_resource);
+                    vec_square(p, last.power(), m_resource);
+                    m_blocks += p.size();
+                    m_entries[n] = std::make_unique<RadixPower>(std::move(p), last.digits() * 2);
+                    m_size.store(++n, std::memory_order_release);
+                }
+                return n;
+            }
+
+        private:
+            std::pmr::memory_resource* m_resource;
+            std::array<std::unique_ptr<RadixPower>, max_entries> m_entries{};
+            std::atomic<std::size_t> m_size{0};
+            std::size_t m_blocks{0};
+            std::mutex m_mutex;
+        };
+
+        template <std::size_t Radix>
+        inline static auto radix_power_cache() -> RadixPowerCache& {
+            static auto cache = RadixPowerCache(Radix);
+            return cache;
+        }
+
+        /**
+         * The powers one conversion walks through: the shared cache first, then
+         * entries of its own for sizes past the cache bound, which go away with
+         * the table.
+        */
+        template <std::size_t Radix>
+        struct RadixPowerTable {
+            RadixPowerTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+                : m_cache(radix_power_cache<Radix>())
+                , m_cached(m_cache.size())
+                , m_local(resource)
+                , m_resource(resource)
+            {}
+
+            auto operator[](std::size_t k) const noexcept -> RadixPower const& {
+                return k < m_cached ? m_cache[k] : m_local[k - m_cached];
+            }
+
+            // Entry k, squared up to if it is not there yet.
+            auto at(std::size_t k) -> RadixPower const& {
+                [[maybe_unused]] auto const ok = grow(k);
+                assert(ok && "radix power past the entry cap");
+                return (*this)[k];
+            }
+
+            // R^digits, straight from the table when it is one of its entries, else built in buf.
+            auto power_of(block_vec_t& buf, std::size_t digits) -> std::span<Integer::value_type const> {
+                constexpr auto d = radix_chunk_digits(Radix);
+                auto const q = digits / d;
+                auto const r = digits % d;
+                if (r == 0 && std::has_single_bit(q)) {
+                    return at(static_cast<std::size_t>(std::countr_zero(q))).power();
+                }
+
+                auto p = MachineConfig::acc_t{1};
+                for (auto i = 0zu; i < r; ++i) p *= Radix;
+                vec_set(buf, p);
+                auto t = block_vec_t(m_resource);
+                for (auto j = 0zu; (q >> j) != 0; ++j) {
+                    if (((q >> j) & 1) == 0) continue;
+                    vec_mul(t, buf, at(j).power(), m_resource);
+                    std::swap(buf, t);
+                }
+                return buf;
+            }
+
+            // Largest k with power(k) no longer than half of `blocks`; blocks >= 2.
+            auto split_index_blocks(std::size_t blocks) -> std::size_t {
+                assert(blocks >= 2);
+                return split_index([blocks](std::size_t, std::size_t size) { return size * 2 <= blocks; });
+            }
+
+            // Largest k with digits(k) at most half of `digits`; digits >= 2 * d.
+            auto split_index_digits(std::size_t digits) -> std::size_t {
+                assert(digits >= 2 * radix_chunk_digits(Radix));
+                return split_index([digits](std::size_t d, std::size_t) { return d * 2 <= digits; });
+            }
+
+        private:
+            /**
+             * fits(digits, blocks) has to be monotone in both. A missing entry is only
+             * squared once its predicted size, twice the previous one, fits; the
+             * real square is never larger, so no power is built just to be rejected.
+            */
+            template <typename Fits>
+            auto split_index(Fits&& fits) -> std::size_t {
+                auto k = 0zu;
+                while (true) {
+                    auto const next = k + 1;
+                    if (next < size()) {
+                        auto const& e = (*this)[next];
+                        if (!fits(e.digits(), e.power().size())) break;
+                    } else {
+                        auto const& e = (*this)[k];
+                        if (!fits(2 * e.digits(), 2 * e.power().size())) break;
+                        if (!grow(next)) break;
+                    }
+                    k = next;
+                }
+                return k;
+            }
+
+            auto size() const noexcept -> std::size_t { return m_cached + m_local.size(); }
+
+            // Makes entry k available; false only when the entry cap is reached.
+            auto grow(std::size_t k) -> bool {
+                if (m_local.empty()) {
+                    m_cached = m_cache.ensure(k);
+                    if (m_cached > k) return true;
+                }
+                while (size() <= k) {
+                    if (size() >= RadixPowerCache::max_entries) return false;
+                    auto const& last = (*this)[size() - 1];
+                    auto p = block_vec_t(m_resource);
+                    vec_square(p, last.power(), m_resource);
+                    m_local.emplace_back(std::move(p), last.digits() * 2);
+                }
+                return true;
+            }
+
+            RadixPowerCache& m_cache;
+            // cache entries this table uses; fixed once it has entries of its own
+            std::size_t m_cached;
+            // deque keeps earlier entries in place while later ones are squared
+            std::pmr::deque<RadixPower> m_local;
+            std::pmr::memory_resource* m_resource;
+        };
+    } // namespace detail
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_RADIX_POWERS_HPP
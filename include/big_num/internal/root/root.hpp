@@ -0,0 +1,180 @@
+#ifndef AMT_BIG_NUM_INTERNAL_ROOT_ROOT_HPP
+#define AMT_BIG_NUM_INTERNAL_ROOT_ROOT_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include "sqrt.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <compare>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+
+namespace big_num::internal {
+    namespace detail {
+        // out = a^k, k >= 1
+        inline static constexpr auto vec_pow(
+            block_vec_t& out,
+            std::span<Integer::value_type const> a,
+            std::size_t k,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            auto base = block_vec_t(a.begin(), a.end(), resource);
+            auto t = block_vec_t(resource);
+            vec_set(out, 1);
+            while (true) {
+                if (k & 1) {
+                    vec_mul(t, out, base, resource);
+                    std::swap(out, t);
+                }
+                k >>= 1;
+                if (k == 0) break;
+                vec_mul(t, base, base, resource);
+                std::swap(base, t);
+            }
+        }
+
+        /**
+         * Seed for the root of a value whose root has at most 52 bits. The estimate
+         * comes from a double and is padded so it never falls below the true root,
+         * since the Newton iteration has to start from above.
+        */
+        inline static constexpr auto iroot_seed(
+            std::span<Integer::value_type const> a,
+            std::size_t k,
+            std::size_t root_bits,
+            std::pmr::memory_resource* resource
+        ) -> MachineConfig::acc_t {
+            using acc_t = MachineConfig::acc_t;
+            auto const fallback = acc_t{1} << root_bits;
+            if (std::is_constant_evaluated()) return fallback;
+
+            auto const n = vec_bits(a);
+            auto const e = n > 53 ? n - 53 : 0zu;
+            auto top = block_vec_t(resource);
+            vec_shift_right(top, a, e);
+            auto const lg = std::log2(static_cast<double>(vec_get(top))) + static_cast<double>(e);
+            auto const y = std::exp2(lg / static_cast<double>(k));
+            auto const x = static_cast<acc_t>(y);
+            return std::min(fallback, x + (x >> 40) + 2);
+        }
+
+        /**
+         * x = floor(a^(1/k)) for a > 0 and k >= 2.
+         * The root of a / 2^(k * h) with h about half of the root's bits is computed
+         * first, (y + 1) * 2^h is then an upper bound with about half of the bits
+         * right, and Newton from above doubles the precision. The recursion bottoms
+         * out at a double seed, so every level only runs a couple of Newton steps on
+         * numbers of the size that level needs.
+        */
+        inline static constexpr auto iroot_rec(
+            block_vec_t& x,
+            std::span<Integer::value_type const> a,
+            std::size_t k,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            auto const n = vec_bits(a);
+            auto const root_bits = (n + k - 1) / k;
+
+            if (root_bits <= 52) {
+                vec_set(x, iroot_seed(a, k, root_bits, resource));
+            } else {
+                auto const h = root_bits / 2;
+                auto hi = block_vec_t(resource);
+                vec_shift_right(hi, a, k * h);
+                auto y = block_vec_t(resource);
+                iroot_rec(y, hi, k, resource);
+                vec_add(y, Integer::value_type{1});
+                vec_shift_left(x, y, h);
+            }
+
+            // x' = ((k - 1) * x + a / x^(k - 1)) / k until it stops decreasing
+            auto kv = block_vec_t(resource);
+            auto km1 = block_vec_t(resource);
+            vec_set(kv, k);
+            vec_set(km1, k - 1);
+            auto p = block_vec_t(resource);
+            auto q = block_vec_t(resource);
+            auto r = block_vec_t(resource);
+            auto t = block_vec_t(resource);
+            auto nx = block_vec_t(resource);
+            while (true) {
+                vec_pow(p, x, k - 1, resource);
+                vec_divrem_prepared(&q, r, a, p, resource);
+                vec_mul(t, x, km1, resource);
+                vec_add(t, q);
+                vec_divrem(&nx, r, t, kv, resource);
+                if (vec_compare(nx, x) != std::strong_ordering::less) break;
+                std::swap(x, nx);
+            }
+        }
+    } // namespace detail
+
+    /**
+     * out = the k-th root of a truncated towards zero, k >= 1.
+     * a may be negative only for odd k; out holds the magnitude and the root has the
+     * sign of a. out needs `(a.size() + k - 1) / k` blocks.
+     * @returns true if the root is exact
+    */
+    inline static constexpr auto iroot(
+        num_t out,
+        const_num_t const& a,
+        std::size_t k,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        assert(k >= 1);
+        assert((!a.is_neg() || (k & 1)) && "iroot: even root of a negative number");
+        auto const m = a.trim_trailing_zeros();
+        assert(out.size() >= (m.size() + k - 1) / k);
+
+        std::fill(out.begin(), out.end(), 0);
+        if (m.empty()) return true;
+        if (k == 1) {
+            std::copy(m.begin(), m.end(), out.begin());
+            return true;
+        }
+        // 1 <= |a| < 2^k, so the root is 1 without running Newton on a huge k
+        if (k >= detail::vec_bits(m.span())) {
+            out[0] = 1;
+            return m.size() == 1 && m[0] == 1;
+        }
+
+        auto x = detail::block_vec_t(resource);
+        auto exact = false;
+        if (k == 2) {
+            auto r = detail::block_vec_t(resource);
+            detail::sqrt_rem_rec(x, r, m, resource);
+            exact = r.empty();
+        } else {
+            detail::iroot_rec(x, m, k, resource);
+            auto p = detail::block_vec_t(resource);
+            detail::vec_pow(p, x, k, resource);
+            exact = detail::vec_compare(p, m.span()) == std::strong_ordering::equal;
+        }
+        std::copy(x.begin(), x.end(), out.begin());
+        return exact;
+    }
+
+    /**
+     * @returns true if the root is exact
+    */
+    inline static constexpr auto iroot(
+        Integer& out,
+        Integer const& a,
+        std::size_t k,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        auto const size = (a.size() + k - 1) / k;
+        auto tmp = detail::block_vec_t(size, 0, resource);
+        auto const exact = iroot(num_t(tmp.data(), size), a.to_span(), k, resource);
+        detail::vec_trim(tmp);
+        detail::vec_to_integer(out, tmp, a.is_neg());
+        return exact;
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_ROOT_ROOT_HPP
@@ -0,0 +1,222 @@
+#ifndef AMT_BIG_NUM_INTERNAL_ROOT_SQRT_HPP
+#define AMT_BIG_NUM_INTERNAL_ROOT_SQRT_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include "../div/prepared.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <memory_resource>
+#include <span>
+
+namespace big_num::internal {
+    namespace detail {
+        // floor(sqrt(v))
+        inline static constexpr auto isqrt_word(MachineConfig::acc_t v) noexcept -> MachineConfig::acc_t {
+            using acc_t = MachineConfig::acc_t;
+            if (v < 2) return v;
+            auto x = acc_t{1} << ((std::bit_width(v) + 1) / 2);
+            while (true) {
+                auto const y = (x + v / x) / 2;
+                if (y >= x) return x;
+                x = y;
+            }
+        }
+
+        /**
+         * `vec_divrem` through a `PreparedDivisor`: divisors of at least
+         * `MachineConfig::div_barrett_threshold` blocks divide with its Newton
+         * reciprocal and two products per quotient chunk.
+        */
+        inline static constexpr auto vec_divrem_prepared(
+            block_vec_t* q,
+            block_vec_t& r,
+            std::span<Integer::value_type const> a,
+            std::span<Integer::value_type const> b,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            auto const d = PreparedDivisor(const_num_t(b.data(), b.size()), resource);
+            auto scratch = block_vec_t(d.scratch_size(a.size()), 0, resource);
+            r.assign(d.size(), 0);
+            auto out_q = num_t{};
+            if (q) {
+                q->assign(d.quotient_size(a.size()), 0);
+                out_q = num_t(q->data(), q->size());
+            }
+            d.divmod(
+                out_q,
+                num_t(r.data(), r.size()),
+                const_num_t(a.data(), a.size()),
+                num_t(scratch.data(), scratch.size()),
+                resource
+            );
+            if (q) vec_trim(*q);
+            vec_trim(r);
+        }
+
+        inline static constexpr auto sqrt_rem_rec(
+            block_vec_t& s,
+            block_vec_t& r,
+            std::span<Integer::value_type const> m,
+            std::pmr::memory_resource* resource
+        ) -> void;
+
+        /**
+         * Zimmermann's Karatsuba square root on a normalized input, i.e. m has
+         * 4k - 1 or 4k bits and is split as m = a3 * b^3 + a2 * b^2 + a1 * b + a0
+         * with b = 2^k and a3 >= b / 4. The split is on bits, so the recursion
+         * never has to renormalize by more than one bit pair.
+        */
+        inline static constexpr auto sqrt_rem_normalized(
+            block_vec_t& s,
+            block_vec_t& r,
+            std::span<Integer::value_type const> m,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            auto const k = (vec_bits(m) + 1) / 4;
+
+            auto hi = block_vec_t(resource);
+            vec_shift_right(hi, m, 2 * k);
+
+            // (s', r') = SqrtRem(a3 * b + a2)
+            auto sp = block_vec_t(resource);
+            auto rp = block_vec_t(resource);
+            sqrt_rem_rec(sp, rp, hi, resource);
+
+            // (q, u) = DivRem(r' * b + a1, 2 * s')
+            auto a1 = block_vec_t(resource);
+            auto t = block_vec_t(resource);
+            vec_shift_right(t, m, k);
+            vec_low_bits(a1, t, k);
+            vec_shift_left(t, rp, k);
+            vec_add(t, a1);
+            auto d = block_vec_t(resource);
+            vec_shift_left(d, sp, 1);
+            auto q = block_vec_t(resource);
+            auto u = block_vec_t(resource);
+            vec_divrem_prepared(&q, u, t, d, resource);
+
+            // s = s' * b + q, r = u * b + a0 - q^2
+            vec_shift_left(s, sp, k);
+            vec_add(s, q);
+
+            auto a0 = block_vec_t(resource);
+            vec_low_bits(a0, m, k);
+            vec_shift_left(r, u, k);
+            vec_add(r, a0);
+
+            auto q2 = block_vec_t(resource);
+            vec_mul(q2, q, q, resource);
+
+            if (vec_compare(r, q2) == std::strong_ordering::less) {
+                // r + 2s - 1 - q^2, s - 1
+                vec_shift_left(t, s, 1);
+                vec_add(r, t);
+                vec_sub(r, Integer::value_type{1});
+                vec_sub(s, Integer::value_type{1});
+            }
+            vec_sub(r, q2);
+        }
+
+        // s = floor(sqrt(m)), r = m - s^2
+        inline static constexpr auto sqrt_rem_rec(
+            block_vec_t& s,
+            block_vec_t& r,
+            std::span<Integer::value_type const> m,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            auto const n = vec_bits(m);
+            if (n <= 2 * MachineConfig::bits) {
+                auto const v = vec_get(m);
+                auto const x = isqrt_word(v);
+                vec_set(s, x);
+                vec_set(r, v - x * x);
+                return;
+            }
+
+            if (n % 4 == 0 || n % 4 == 3) {
+                sqrt_rem_normalized(s, r, m, resource);
+                return;
+            }
+
+            // sqrt(4m) = 2s + s0 with s0 in {0, 1}; 4m - (2s + s0)^2 = R gives
+            // r = (R + s0 * (2S - 1)) / 4 where S = 2s + s0.
+            auto m4 = block_vec_t(resource);
+            vec_shift_left(m4, m, 2);
+            auto big_s = block_vec_t(resource);
+            auto big_r = block_vec_t(resource);
+            sqrt_rem_normalized(big_s, big_r, m4, resource);
+
+            if (big_s[0] & 1) {
+                auto t = block_vec_t(resource);
+                vec_shift_left(t, big_s, 1);
+                vec_add(big_r, t);
+                vec_sub(big_r, Integer::value_type{1});
+            }
+            vec_shift_right(s, big_s, 1);
+            vec_shift_right(r, big_r, 2);
+        }
+    } // namespace detail
+
+    /**
+     * out_s = floor(sqrt(a)) and out_r = a - out_s^2 using Zimmermann's Karatsuba
+     * square root. a must be non-negative; out_s needs `(a.size() + 1) / 2` blocks
+     * and out_r `a.size() / 2 + 1` blocks.
+     * The division step goes through `PreparedDivisor`, so on large inputs it is a
+     * few products and the cost follows the `mul` tiers.
+     * @returns true if a is a perfect square
+    */
+    inline static constexpr auto isqrt_rem(
+        num_t out_s,
+        num_t out_r,
+        const_num_t const& a,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        assert(!a.is_neg() && "isqrt_rem: negative input");
+        auto const m = a.trim_trailing_zeros();
+        assert(out_s.size() >= (m.size() + 1) / 2);
+        assert(out_r.size() >= std::min(m.size(), m.size() / 2 + 1));
+
+        auto s = detail::block_vec_t(resource);
+        auto r = detail::block_vec_t(resource);
+        detail::sqrt_rem_rec(s, r, m, resource);
+
+        std::fill(out_s.begin(), out_s.end(), 0);
+        std::fill(out_r.begin(), out_r.end(), 0);
+        std::copy(s.begin(), s.end(), out_s.begin());
+        std::copy(r.begin(), r.end(), out_r.begin());
+        return r.empty();
+    }
+
+    /**
+     * @returns true if a is a perfect square
+    */
+    inline static constexpr auto isqrt_rem(
+        Integer& out_s,
+        Integer& out_r,
+        Integer const& a,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> bool {
+        assert(!a.is_neg() && "isqrt_rem: negative input");
+        auto s = detail::block_vec_t(resource);
+        auto r = detail::block_vec_t(resource);
+        detail::sqrt_rem_rec(s, r, a.to_span().trim_trailing_zeros(), resource);
+        detail::vec_to_integer(out_s, s);
+        detail::vec_to_integer(out_r, r);
+        return r.empty();
+    }
+
+    inline static constexpr auto isqrt(
+        Integer& out,
+        Integer const& a,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto r = Integer{};
+        isqrt_rem(out, r, a, resource);
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_ROOT_SQRT_HPP
@@ -0,0 +1,220 @@
+#ifndef AMT_BIG_NUM_INTERNAL_SERIES_BINARY_SPLIT_HPP
+#define AMT_BIG_NUM_INTERNAL_SERIES_BINARY_SPLIT_HPP
+
+#include "../integer.hpp"
+#include "../base.hpp"
+#include "../block_vec.hpp"
+#include "../parallel.hpp"
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <initializer_list>
+#include <memory_resource>
+#include <thread>
+#include <utility>
+
+namespace big_num::internal {
+    /**
+     * A term of the series sum over k of a(k) p(0) ... p(k) / (q(0) ... q(k)):
+     * term(k, p, q, a) writes p(k), q(k) and a(k), any of which may be negative.
+    */
+    template <typename Term>
+    concept BinarySplitTerm = requires(Term const& term, std::size_t k, Integer& p, Integer& q, Integer& a) {
+        { term(k, p, q, a) };
+    };
+
+    /**
+     * out = (-1)^neg * product of the words; for building terms out of small factors.
+     * A word is a plain value, not a block, so any `value_type` is fine.
+    */
+    inline static constexpr auto assign_word_product(
+        Integer& out,
+        std::initializer_list<Integer::value_type> words,
+        bool neg = false,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        auto v = detail::block_vec_t(resource);
+        detail::vec_set(v, 1);
+        for (auto w : words) detail::vec_mul_word(v, w);
+        detail::vec_to_integer(out, v, neg);
+    }
+
+    namespace detail {
+        // P, Q and T of a range with their signs.
+        struct BinarySplitNode {
+            block_vec_t p;
+            block_vec_t q;
+            block_vec_t t;
+            bool p_neg{false};
+            bool q_neg{false};
+            bool t_neg{false};
+
+            BinarySplitNode(std::pmr::memory_resource* resource)
+                : p(resource)
+                , q(resource)
+                , t(resource)
+            {}
+        };
+
+        inline static auto vec_release(block_vec_t& a) -> void {
+            a.clear();
+            a.shrink_to_fit();
+        }
+
+        // a += b for sign-magnitude values
+        inline static constexpr auto signed_vec_add(
+            block_vec_t& a,
+            bool& a_neg,
+            block_vec_t const& b,
+            bool b_neg
+        ) -> void {
+            if (a_neg == b_neg) {
+                vec_add(a, b);
+                return;
+            }
+            if (vec_compare(a, b) != std::strong_ordering::less) {
+                vec_sub(a, b);
+            } else {
+                auto t = block_vec_t(b.begin(), b.end(), a.get_allocator());
+                vec_sub(t, a);
+                std::swap(a, t);
+                a_neg = b_neg;
+            }
+            a_neg = a_neg && !a.empty();
+        }
+
+        /**
+         * P(a, b) = p(a) ... p(b - 1), Q(a, b) = q(a) ... q(b - 1) and
+         * T(a, b) = sum over a <= k < b of a(k) P(a, k + 1) Q(k + 1, b), merged as
+         *   T(a, b) = T(a, m) Q(m, b) + P(a, m) T(m, b).
+         * A child's numbers are released right after their last product, so a level
+         * holds little more than its parent's result. P is only formed when the
+         * caller asks for it; the right spine of the tree never needs it.
+         * The two halves run on separate threads while `threads` allows it.
+        */
+        template <typename Term>
+        inline static auto binary_split_rec(
+            BinarySplitNode& out,
+            Term const& term,
+            std::size_t a,
+            std::size_t b,
+            bool need_p,
+            std::size_t threads,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            if (b - a == 1) {
+                auto p = Integer{};
+                auto q = Integer{};
+                auto c = Integer{};
+                term(a, p, q, c);
+                auto const ps = p.to_span().trim_trailing_zeros().span();
+                auto const qs = q.to_span().trim_trailing_zeros().span();
+                auto const cs = c.to_span().trim_trailing_zeros().span();
+                assert(!qs.empty() && "q(k) cannot be zero");
+                out.p.assign(ps.begin(), ps.end());
+                out.q.assign(qs.begin(), qs.end());
+                vec_mul(out.t, cs, ps, resource);
+                out.p_neg = p.is_neg() && !ps.empty();
+                out.q_neg = q.is_neg();
+                out.t_neg = (c.is_neg() != p.is_neg()) && !out.t.empty();
+                return;
+            }
+
+            auto const m = a + (b - a) / 2;
+            auto l = BinarySplitNode(resource);
+            auto r = BinarySplitNode(resource);
+            if (threads > 1) {
+                auto const lt = threads / 2;
+                auto worker = std::jthread([&] {
+                    binary_split_rec(l, term, a, m, true, lt, resource);
+                });
+                binary_split_rec(r, term, m, b, need_p, threads - lt, resource);
+            } else {
+                binary_split_rec(l, term, a, m, true, 1, resource);
+                binary_split_rec(r, term, m, b, need_p, 1, resource);
+            }
+
+            auto tmp = block_vec_t(resource);
+            vec_mul(out.t, l.t, r.q, resource);
+            out.t_neg = (l.t_neg != r.q_neg) && !out.t.empty();
+            vec_release(l.t);
+            vec_mul(tmp, l.p, r.t, resource);
+            vec_release(r.t);
+            signed_vec_add(out.t, out.t_neg, tmp, (l.p_neg != r.t_neg) && !tmp.empty());
+            vec_release(tmp);
+
+            if (need_p) {
+                vec_mul(out.p, l.p, r.p, resource);
+                out.p_neg = (l.p_neg != r.p_neg) && !out.p.empty();
+            }
+            vec_release(l.p);
+            vec_release(r.p);
+
+            vec_mul(out.q, l.q, r.q, resource);
+            out.q_neg = l.q_neg != r.q_neg;
+        }
+
+        template <typename Term>
+        inline static auto binary_split_impl(
+            Integer* out_p,
+            Integer& out_q,
+            Integer& out_t,
+            Term const& term,
+            std::size_t a,
+            std::size_t b,
+            std::size_t threads,
+            std::pmr::memory_resource* resource
+        ) -> void {
+            assert(a < b && "binary_split: empty range");
+            if (threads == 0) threads = hardware_threads();
+            auto node = BinarySplitNode(resource);
+            binary_split_rec(node, term, a, b, out_p != nullptr, threads, resource);
+            if (out_p) vec_to_integer(*out_p, node.p, node.p_neg);
+            vec_to_integer(out_q, node.q, node.q_neg);
+            vec_to_integer(out_t, node.t, node.t_neg);
+        }
+    } // namespace detail
+
+    /**
+     * Binary splitting over [a, b) for a series given by `term`, see
+     * `BinarySplitTerm`: out_p = P(a, b), out_q = Q(a, b), out_t = T(a, b) with
+     *   P(a, b) = p(a) ... p(b - 1), Q(a, b) = q(a) ... q(b - 1),
+     *   T(a, b) = sum over a <= k < b of a(k) P(a, k + 1) Q(k + 1, b),
+     * so the partial sum is T(a, b) / Q(a, b). Ranges are halved recursively and
+     * each merge is three or four products of about equal sizes, which keeps them
+     * in the fast `mul` tiers. The top levels of the recursion are spread over
+     * `threads` (0 = all hardware threads); term has to be callable concurrently.
+    */
+    template <BinarySplitTerm Term>
+    inline static auto binary_split(
+        Integer& out_p,
+        Integer& out_q,
+        Integer& out_t,
+        Term const& term,
+        std::size_t a,
+        std::size_t b,
+        std::size_t threads = 1,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        detail::binary_split_impl(&out_p, out_q, out_t, term, a, b, threads, resource);
+    }
+
+    /**
+     * Same as above when only the sum is needed; P of the whole range is never formed.
+    */
+    template <BinarySplitTerm Term>
+    inline static auto binary_split(
+        Integer& out_q,
+        Integer& out_t,
+        Term const& term,
+        std::size_t a,
+        std::size_t b,
+        std::size_t threads = 1,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()
+    ) -> void {
+        detail::binary_split_impl(nullptr, out_q, out_t, term, a, b, threads, resource);
+    }
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_SERIES_BINARY_SPLIT_HPP
@@ -0,0 +1,126 @@
+#ifndef AMT_BIG_NUM_INTERNAL_SWAR_HPP
+#define AMT_BIG_NUM_INTERNAL_SWAR_HPP
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace big_num::internal {
+    // Digit handling on eight ASCII characters at a time, packed into one 64-bit word.
+    namespace detail {
+        // p[0, 8) with p[0] in the low byte on any host.
+        inline static constexpr auto swar_load8(char const* p) noexcept -> std::uint64_t {
+            auto v = std::uint64_t{};
+            if (!std::is_constant_evaluated()) {
+                std::memcpy(&v, p, sizeof(v));
+                if constexpr (std::endian::native == std::endian::big) v = std::byteswap(v);
+                return v;
+            }
+            for (auto i = 0zu; i < 8; ++i) {
+                v |= std::uint64_t{static_cast<unsigned char>(p[i])} << (8 * i);
+            }
+            return v;
+        }
+
+        // Every byte is in '0'...'9'.
+        inline static constexpr auto swar_is_decimal8(std::uint64_t v) noexcept -> bool {
+            constexpr auto high = std::uint64_t{0xF0F0'F0F0'F0F0'F0F0};
+            return ((v & high) | (((v + 0x0606'0606'0606'0606) & high) >> 4)) == 0x3333'3333'3333'3333;
+        }
+
+        /**
+         * Value of eight decimal digits, the first byte the most significant.
+         * Neighbouring lanes are merged pairwise, so three multiplies replace
+         * seven multiply-adds:
+         *   bytes -> 2 digit lanes -> 4 digit lanes -> 8 digits
+        */
+        inline static constexpr auto swar_decimal8(std::uint64_t v) noexcept -> std::uint32_t {
+            v -= 0x3030'3030'3030'3030;
+            v = (v * 10 + (v >> 8)) & 0x00FF'00FF'00FF'00FF;
+            v = (v * 100 + (v >> 16)) & 0x0000'FFFF'0000'FFFF;
+            v = (v * 10'000 + (v >> 32)) & 0xFFFF'FFFF;
+            return static_cast<std::uint32_t>(v);
+        }
+
+        // p[0, 8) = bytes of v, the low byte first.
+        inline static constexpr auto swar_store8(char* p, std::uint64_t v) noexcept -> void {
+            if (!std::is_constant_evaluated()) {
+                if constexpr (std::endian::native == std::endian::big) v = std::byteswap(v);
+                std::memcpy(p, &v, sizeof(v));
+                return;
+            }
+            for (auto i = 0zu; i < 8; ++i) {
+                p[i] = static_cast<char>(v >> (8 * i));
+            }
+        }
+
+        // High bit set in every byte b with lo <= b <= hi; 0 < lo <= hi < 127.
+        inline static constexpr auto swar_in_range(std::uint64_t v, std::uint8_t lo, std::uint8_t hi) noexcept -> std::uint64_t {
+            constexpr auto ones = std::uint64_t{0x0101'0101'0101'0101};
+            auto const x = v & (ones * 127);
+            return (ones * (128u + hi) - x) & ~v & (x + ones * (128u - lo)) & (ones * 128);
+        }
+
+        /**
+         * Packs eight digits of a power-of-two radix, the first byte the most
+         * significant, into their 8 log2(Radix) bits.
+         * @returns false if a byte is not a digit of the radix
+        */
+        template <std::size_t Radix>
+            requires (Radix == 2 || Radix == 8 || Radix == 16)
+        inline static constexpr auto swar_pack8(std::uint64_t v, std::uint64_t& out) noexcept -> bool {
+            constexpr auto ones = std::uint64_t{0x0101'0101'0101'0101};
+            if constexpr (Radix == 2) {
+                if ((v & (ones * 0xFE)) != ones * 0x30) return false;
+                out = ((std::byteswap(v) & ones) * 0x0102'0408'1020'4080) >> 56;
+            } else if constexpr (Radix == 8) {
+                if ((v & (ones * 0xF8)) != ones * 0x30) return false;
+                auto x = std::byteswap(v) & (ones * 7);
+                x = (x | (x >> 5)) & 0x003F'003F'003F'003F;
+                x = (x | (x >> 10)) & 0x0000'0FFF'0000'0FFF;
+                out = (x | (x >> 20)) & 0xFF'FFFF;
+            } else {
+                auto const digit = swar_in_range(v, '0', '9');
+                auto const letter = swar_in_range(v | (ones * 0x20), 'a', 'f');
+                if ((digit | letter) != ones * 128) return false;
+                auto x = std::byteswap((v & (ones * 0xF)) + (letter >> 7) * 9);
+                x = (x | (x >> 4)) & 0x00FF'00FF'00FF'00FF;
+                x = (x | (x >> 8)) & 0x0000'FFFF'0000'FFFF;
+                out = (x | (x >> 16)) & 0xFFFF'FFFF;
+            }
+            return true;
+        }
+
+        /**
+         * The eight ASCII digits of the low 8 log2(Radix) bits of v, the most
+         * significant in the low byte; lowercase for hex.
+        */
+        template <std::size_t Radix>
+            requires (Radix == 2 || Radix == 8 || Radix == 16)
+        inline static constexpr auto swar_unpack8(std::uint64_t v) noexcept -> std::uint64_t {
+            constexpr auto ones = std::uint64_t{0x0101'0101'0101'0101};
+            auto x = std::uint64_t{};
+            if constexpr (Radix == 2) {
+                x = ((v & 0xFF) * ones) & 0x8040'2010'0804'0201;
+                x = ((x + ones * 0x7F) >> 7) & ones;
+            } else if constexpr (Radix == 8) {
+                x = v & 0xFF'FFFF;
+                x = (x | (x << 20)) & 0x0000'0FFF'0000'0FFF;
+                x = (x | (x << 10)) & 0x003F'003F'003F'003F;
+                x = (x | (x << 5)) & 0x0707'0707'0707'0707;
+            } else {
+                x = v & 0xFFFF'FFFF;
+                x = (x | (x << 16)) & 0x0000'FFFF'0000'FFFF;
+                x = (x | (x << 8)) & 0x00FF'00FF'00FF'00FF;
+                x = (x | (x << 4)) & 0x0F0F'0F0F'0F0F'0F0F;
+                // 'a' - '0' - 10 past the digits for nibbles above nine
+                x += (((x + ones * 6) >> 4) & ones) * 39;
+            }
+            return std::byteswap(x + ones * 0x30);
+        }
+    } // namespace detail
+} // namespace big_num::internal
+
+#endif // AMT_BIG_NUM_INTERNAL_SWAR_HPP
@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/mod/barrett.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+TEST_CASE("Barrett reduction", "[mod:barrett]") {
+	SECTION("Known values") {
+		auto m = make("0x7fffffffffffffffffffffffffffffff"); // 2^127 - 1
+		auto ctx = BarrettContext(m.to_span());
+		auto r = Integer{};
+		ctx.reduce(r, make("369988485035126972924700782451696644186473100389722973815184405301748249")); // 3^150
+		REQUIRE(to_string(r.to_span()) == "22993705630796773582160019976843401191");
+
+		auto ctx2 = BarrettContext(make("1000000000000000000000000000057").to_span());
+		ctx2.reduce(r, make("1606938044258990275541962092341162602522202993782792835301375")); // 2^200 - 1
+		REQUIRE(to_string(r.to_span()) == "567133999440548076900996043182");
+	}
+
+	SECTION("Against naive division") {
+		auto g = std::mt19937_64(26);
+		for (auto k : { 1zu, 2zu, 3zu, 5zu, 8zu, 17zu, 40zu }) {
+			for (auto ones : { false, true }) {
+				auto m = random_integer(g, k, false, ones);
+				auto ctx = BarrettContext(m.to_span());
+				for (auto xs = 0zu; xs <= 2 * k; ++xs) {
+					auto x = random_integer(g, xs, false, ones && xs == 2 * k);
+					auto r = Integer{};
+					ctx.reduce(r, x);
+					REQUIRE(hex(r) == hex(naive_mod(x, m)));
+				}
+			}
+		}
+	}
+
+	SECTION("Multiples and values next to the modulus") {
+		auto g = std::mt19937_64(261);
+		auto m = random_integer(g, 6);
+		auto ctx = BarrettContext(m.to_span());
+		auto r = Integer{};
+
+		ctx.reduce(r, m);
+		REQUIRE(r.empty());
+
+		auto x = naive_product(m, random_integer(g, 6));
+		ctx.reduce(r, x);
+		REQUIRE(r.empty());
+
+		auto mm1 = from_blocks(std::vector<Integer::value_type>(m.begin(), m.end()));
+		abs_sub(mm1.to_span(), Integer::value_type{1});
+		ctx.reduce(r, mm1);
+		REQUIRE(hex(r) == hex(mm1));
+	}
+
+	SECTION("Multiples of B^(k + 1)") {
+		// x mod B^(k + 1) is zero, so the low difference always borrows.
+		auto r = Integer{};
+		auto ctx = BarrettContext(make("0x2000000000000001").to_span()); // 2^61 + 1
+		ctx.reduce(r, make("0x200000000000000000000000")); // 2^93
+		REQUIRE(to_string(r.to_span()) == "2305843004918726657");
+
+		auto ctx2 = BarrettContext(make("0x40000000000000000000002").to_span()); // 2^90 + 2
+		ctx2.reduce(r, make("0x100000000000000000000000000000000")); // 2^128
+		REQUIRE(to_string(r.to_span()) == "1237940039285379725143310338");
+
+		auto g = std::mt19937_64(264);
+		for (auto k : { 1zu, 2zu, 3zu, 6zu, 17zu }) {
+			auto m = random_integer(g, k);
+			auto ctx3 = BarrettContext(m.to_span());
+			for (auto cs = 1zu; cs < k; ++cs) {
+				auto c = random_integer(g, cs);
+				auto blocks = std::vector<Integer::value_type>(k + 1, 0);
+				blocks.insert(blocks.end(), c.begin(), c.end());
+				auto x = from_blocks(blocks);
+				ctx3.reduce(r, x);
+				REQUIRE(hex(r) == hex(naive_mod(x, m)));
+			}
+		}
+	}
+
+	SECTION("Span overload with caller scratch") {
+		auto g = std::mt19937_64(262);
+		auto m = random_integer(g, 9);
+		auto x = random_integer(g, 17);
+		auto const ctx = BarrettContext(m.to_span());
+		auto out = std::vector<Integer::value_type>(ctx.size() + 2, 0x5a5a);
+		auto scratch = std::vector<Integer::value_type>(ctx.scratch_size());
+		ctx.reduce(num_t(out.data(), out.size()), x.to_span(), num_t(scratch.data(), scratch.size()));
+		REQUIRE(hex(const_num_t(out.data(), out.size())) == hex(naive_mod(x, m)));
+	}
+
+	SECTION("Output aliasing the input") {
+		auto g = std::mt19937_64(263);
+		for (auto xs : { 3zu, 7zu, 14zu }) {
+			auto m = random_integer(g, 7);
+			auto ctx = BarrettContext(m.to_span());
+			auto x = random_integer(g, xs);
+			auto expected = hex(naive_mod(x, m));
+			ctx.reduce(x, x);
+			REQUIRE(hex(x) == expected);
+		}
+	}
+}
@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/series/binary_split.hpp"
+#include "test_helpers.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	auto word(std::size_t v) -> Integer {
+		return make(std::to_string(v));
+	}
+
+	// Mixed signs, a zero a(k) now and then, and factors of a full word.
+	struct TestTerm {
+		auto operator()(std::size_t k, Integer& p, Integer& q, Integer& a) const -> void {
+			auto const w = static_cast<Integer::value_type>(k);
+			assign_word_product(p, { 7 * w + 3 }, k % 5 == 0);
+			assign_word_product(q, { w + 1, w % 4 == 3 ? ~Integer::value_type{} : w + 2 }, k % 3 == 0);
+			a = make(std::to_string(static_cast<int>(k % 4) - 1));
+		}
+	};
+
+	struct Sums {
+		Integer p;
+		Integer q;
+		Integer t;
+	};
+
+	// P, Q and T straight from their definitions.
+	auto naive_split(std::size_t a, std::size_t b) -> Sums {
+		auto const term = TestTerm{};
+		auto ps = std::vector<Integer>{};
+		auto qs = std::vector<Integer>{};
+		auto as = std::vector<Integer>{};
+		for (auto k = a; k < b; ++k) {
+			auto p = Integer{};
+			auto q = Integer{};
+			auto c = Integer{};
+			term(k, p, q, c);
+			ps.push_back(p);
+			qs.push_back(q);
+			as.push_back(c);
+		}
+		auto const prod = [&](std::vector<Integer> const& v, std::size_t i, std::size_t j) {
+			auto r = make("1");
+			for (auto k = i; k < j; ++k) r = naive_product(r, v[k]);
+			return r;
+		};
+		auto res = Sums{ prod(ps, 0, b - a), prod(qs, 0, b - a), make("0") };
+		for (auto k = 0zu; k < b - a; ++k) {
+			res.t = naive_sum(res.t, naive_product(naive_product(as[k], prod(ps, 0, k + 1)), prod(qs, k + 1, b - a)));
+		}
+		return res;
+	}
+} // namespace
+
+TEST_CASE("Word products", "[series:assign_word_product]") {
+	auto r = Integer{};
+	assign_word_product(r, {});
+	REQUIRE(to_string(r.to_span()) == "1");
+	assign_word_product(r, { 2, 3, 7 }, true);
+	REQUIRE(to_string(r.to_span()) == "-42");
+	assign_word_product(r, { 5, 0 }, true);
+	REQUIRE(r.empty());
+	REQUIRE(!r.is_neg());
+
+	// words are plain values, so the top bit of a block is allowed
+	auto const full = ~Integer::value_type{};
+	assign_word_product(r, { full, full, 3 });
+	REQUIRE(to_string(r.to_span()) == "55340232195358851075");
+}
+
+TEST_CASE("Binary splitting", "[series:binary_split]") {
+	SECTION("Against the definitions") {
+		for (auto [a, b] : { std::pair{ 0zu, 1zu }, { 0zu, 2zu }, { 3zu, 4zu }, { 0zu, 13zu }, { 5zu, 40zu }, { 1zu, 64zu } }) {
+			auto const expected = naive_split(a, b);
+			for (auto threads : { 1zu, 4zu, 0zu }) {
+				auto p = Integer{};
+				auto q = Integer{};
+				auto t = Integer{};
+				binary_split(p, q, t, TestTerm{}, a, b, threads);
+				REQUIRE(hex(p) == hex(expected.p));
+				REQUIRE(hex(q) == hex(expected.q));
+				REQUIRE(hex(t) == hex(expected.t));
+
+				auto q2 = Integer{};
+				auto t2 = Integer{};
+				binary_split(q2, t2, TestTerm{}, a, b, threads);
+				REQUIRE(hex(q2) == hex(expected.q));
+				REQUIRE(hex(t2) == hex(expected.t));
+			}
+		}
+	}
+
+	SECTION("Partial sums of e") {
+		// sum 1 / k! for k in [0, n): p = 1, q(0) = 1, q(k) = k, a = 1, so Q = (n - 1)!
+		auto const term = [](std::size_t k, Integer& p, Integer& q, Integer& a) {
+			assign_word_product(p, { 1 });
+			assign_word_product(q, { static_cast<Integer::value_type>(k == 0 ? 1 : k) });
+			assign_word_product(a, { 1 });
+		};
+		auto q = Integer{};
+		auto t = Integer{};
+		binary_split(q, t, term, 0, 300, 3);
+
+		auto expected_q = make("1");
+		for (auto k = 1zu; k < 300; ++k) expected_q = naive_product(expected_q, word(k));
+		REQUIRE(hex(q) == hex(expected_q));
+
+		// T = sum over k of (n - 1)! / k!, built from the top down
+		auto expected_t = make("1");
+		auto falling = make("1");
+		for (auto k = 299zu; k > 0; --k) {
+			falling = naive_product(falling, word(k));
+			expected_t = naive_sum(expected_t, falling);
+		}
+		REQUIRE(hex(t) == hex(expected_t));
+	}
+}
@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/mod/crt.hpp"
+#include "big_num/internal/div/mod.hpp"
+#include "big_num/internal/prime/sieve.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	// The last `count` primes up to `bound`, largest first.
+	auto large_primes(std::size_t count, std::size_t bound) -> std::vector<Integer::value_type> {
+		auto primes = std::pmr::vector<Integer::value_type>{};
+		primes_up_to(primes, bound);
+		REQUIRE(primes.size() >= count);
+		return std::vector<Integer::value_type>(primes.rbegin(), primes.rbegin() + static_cast<std::ptrdiff_t>(count));
+	}
+
+	auto residues_of(Integer const& x, std::span<Integer::value_type const> moduli) -> std::vector<Integer::value_type> {
+		auto res = std::vector<Integer::value_type>{};
+		for (auto m : moduli) res.push_back(mod_1(x, m));
+		return res;
+	}
+
+	// Random x in [0, M).
+	auto below(std::mt19937_64& g, const_num_t const& m) -> Integer {
+		auto const mi = from_blocks(std::span(m.data(), m.size()));
+		return naive_mod(random_integer(g, m.size() + 1), mi);
+	}
+} // namespace
+
+TEST_CASE("Chinese remainder reconstruction", "[mod:crt]") {
+	SECTION("Known values") {
+		auto const moduli = std::vector<Integer::value_type>{ 3, 5, 7 };
+		auto const basis = CrtBasis(moduli);
+		REQUIRE(basis.uses_garner());
+		REQUIRE(to_string(basis.product()) == "105");
+		auto x = Integer{};
+		basis.reconstruct(x, std::vector<Integer::value_type>{ 2, 3, 2 });
+		REQUIRE(to_string(x.to_span()) == "23");
+		basis.reconstruct(x, std::vector<Integer::value_type>{ 0, 0, 0 });
+		REQUIRE(x.empty());
+		basis.reconstruct(x, std::vector<Integer::value_type>{ 2, 4, 6 });
+		REQUIRE(to_string(x.to_span()) == "104");
+	}
+
+	SECTION("Prime powers and the largest block") {
+		auto const moduli = std::vector<Integer::value_type>{
+			MachineConfig::mask, 1u << 30, 1162261467, 1220703125, 1977326743, 214358881, 815730721
+		};
+		auto const basis = CrtBasis(moduli);
+		auto g = std::mt19937_64(38);
+		for (auto i = 0; i < 20; ++i) {
+			auto const x = below(g, basis.product());
+			auto out = Integer{};
+			basis.reconstruct(out, residues_of(x, moduli));
+			REQUIRE(hex(out) == hex(x));
+		}
+	}
+
+	SECTION("Garner and the tree path") {
+		auto g = std::mt19937_64(381);
+		auto const threshold = MachineConfig::crt_garner_threshold;
+		for (auto count : { 1zu, 2zu, 9zu, 100zu, threshold, threshold + 1, threshold + 77 }) {
+			auto const moduli = large_primes(count, 1zu << 20);
+			auto const basis = CrtBasis(moduli);
+			REQUIRE(basis.uses_garner() == (count <= threshold));
+			for (auto i = 0; i < 3; ++i) {
+				auto const x = below(g, basis.product());
+				auto out = Integer{};
+				basis.reconstruct(out, residues_of(x, moduli));
+				REQUIRE(hex(out) == hex(x));
+			}
+		}
+	}
+
+	SECTION("Span overload with caller scratch") {
+		auto g = std::mt19937_64(383);
+		for (auto count : { 5zu, MachineConfig::crt_garner_threshold + 11 }) {
+			auto const moduli = large_primes(count, 1zu << 20);
+			auto const basis = CrtBasis(moduli);
+			auto const n = basis.product().size();
+			auto out = std::vector<Integer::value_type>(n + 2, 0x5a5a);
+			auto scratch = std::vector<Integer::value_type>(basis.scratch_size(), 0x5a5a);
+			for (auto i = 0; i < 3; ++i) {
+				auto const x = below(g, basis.product());
+				basis.reconstruct(num_t(out.data(), out.size()), residues_of(x, moduli), num_t(scratch.data(), scratch.size()));
+				REQUIRE(hex(const_num_t(out.data(), out.size())) == hex(x));
+			}
+		}
+	}
+
+	SECTION("Batch and threads") {
+		auto g = std::mt19937_64(382);
+		for (auto count : { 40zu, MachineConfig::crt_garner_threshold + 3 }) {
+			auto const moduli = large_primes(count, 1zu << 20);
+			auto expected = std::vector<Integer>{};
+			auto residues = std::vector<Integer::value_type>{};
+			auto const serial = CrtBasis(moduli);
+			for (auto j = 0; j < 6; ++j) {
+				expected.push_back(below(g, serial.product()));
+				auto const r = residues_of(expected.back(), moduli);
+				residues.insert(residues.end(), r.begin(), r.end());
+			}
+
+			for (auto threads : { 1zu, 3zu, 0zu }) {
+				auto const basis = CrtBasis(moduli, threads);
+				auto out = std::vector<Integer>(expected.size());
+				basis.reconstruct_batch(out, residues, threads);
+				for (auto j = 0zu; j < out.size(); ++j) REQUIRE(hex(out[j]) == hex(expected[j]));
+			}
+		}
+	}
+}
@@ -0,0 +1,112 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/comb/factorial.hpp"
+#include "test_helpers.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	auto word(std::size_t v) -> Integer {
+		return make(std::to_string(v));
+	}
+} // namespace
+
+TEST_CASE("Factorial", "[comb:factorial]") {
+	SECTION("Known values") {
+		auto f = Integer{};
+		factorial(f, 0);
+		REQUIRE(to_string(f.to_span()) == "1");
+		factorial(f, 1);
+		REQUIRE(to_string(f.to_span()) == "1");
+		factorial(f, 20);
+		REQUIRE(to_string(f.to_span()) == "2432902008176640000");
+		factorial(f, 100);
+		REQUIRE(to_string(f.to_span()) == "93326215443944152681699238856266700490715968264381621468592963895217599993229915608941463976156518286253697920827223758251185210916864000000000000000000000000");
+	}
+
+	SECTION("Against the running product") {
+		auto expected = make("1");
+		for (auto n = 1zu; n <= 1500; ++n) {
+			expected = naive_product(expected, word(n));
+			if (n <= 300 || n % 97 == 0 || n == 1500) {
+				auto f = Integer{};
+				factorial(f, n);
+				REQUIRE(hex(f) == hex(expected));
+			}
+		}
+	}
+
+	SECTION("Double factorial") {
+		auto f = Integer{};
+		double_factorial(f, 0);
+		REQUIRE(to_string(f.to_span()) == "1");
+		double_factorial(f, 25);
+		REQUIRE(to_string(f.to_span()) == "7905853580625");
+		double_factorial(f, 30);
+		REQUIRE(to_string(f.to_span()) == "42849873690624000");
+
+		auto even = make("1");
+		auto odd = make("1");
+		for (auto n = 1zu; n <= 600; ++n) {
+			auto& expected = n % 2 ? odd : even;
+			expected = naive_product(expected, word(n));
+			double_factorial(f, n);
+			REQUIRE(hex(f) == hex(expected));
+		}
+	}
+}
+
+TEST_CASE("Binomial coefficient", "[comb:binomial]") {
+	SECTION("Known values") {
+		auto c = Integer{};
+		binomial(c, 100, 50);
+		REQUIRE(to_string(c.to_span()) == "100891344545564193334812497256");
+		binomial(c, 10, 11);
+		REQUIRE(c.empty());
+		binomial(c, 0, 0);
+		REQUIRE(to_string(c.to_span()) == "1");
+		binomial(c, 1000, 1);
+		REQUIRE(to_string(c.to_span()) == "1000");
+		binomial(c, 1000, 999);
+		REQUIRE(to_string(c.to_span()) == "1000");
+	}
+
+	SECTION("Pascal's triangle") {
+		auto row = std::vector<Integer>{ make("1") };
+		for (auto n = 1zu; n <= 160; ++n) {
+			auto next = std::vector<Integer>{ make("1") };
+			for (auto k = 1zu; k < n; ++k) next.push_back(naive_sum(row[k - 1], row[k]));
+			next.push_back(make("1"));
+			row = std::move(next);
+			for (auto k = 0zu; k <= n; ++k) {
+				auto c = Integer{};
+				binomial(c, n, k);
+				REQUIRE(hex(c) == hex(row[k]));
+			}
+		}
+	}
+}
+
+TEST_CASE("Primorial", "[comb:primorial]") {
+	auto p = Integer{};
+	primorial(p, 0);
+	REQUIRE(to_string(p.to_span()) == "1");
+	primorial(p, 1);
+	REQUIRE(to_string(p.to_span()) == "1");
+	primorial(p, 100);
+	REQUIRE(to_string(p.to_span()) == "2305567963945518424753102147331756070");
+
+	auto expected = make("1");
+	for (auto n = 2zu; n <= 4000; ++n) {
+		auto prime = true;
+		for (auto d = 2zu; d * d <= n; ++d) prime = prime && n % d != 0;
+		if (prime) expected = naive_product(expected, word(n));
+		if (n <= 200 || n % 331 == 0) {
+			primorial(p, n);
+			REQUIRE(hex(p) == hex(expected));
+		}
+	}
+}
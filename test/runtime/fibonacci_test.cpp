@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/comb/fibonacci.hpp"
+#include "test_helpers.hpp"
+#include <string>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+TEST_CASE("Fibonacci and Lucas numbers", "[comb:fibonacci]") {
+	SECTION("Known values") {
+		auto f = Integer{};
+		fibonacci(f, 0);
+		REQUIRE(f.empty());
+		fibonacci(f, 1);
+		REQUIRE(to_string(f.to_span()) == "1");
+		fibonacci(f, 100);
+		REQUIRE(to_string(f.to_span()) == "354224848179261915075");
+
+		fibonacci(f, 1000);
+		auto const s = to_string(f.to_span());
+		REQUIRE(s.size() == 209);
+		REQUIRE(s.starts_with("43466557686937456435"));
+		REQUIRE(s.ends_with("76137795166849228875"));
+
+		auto l = Integer{};
+		lucas(l, 0);
+		REQUIRE(to_string(l.to_span()) == "2");
+		lucas(l, 1);
+		REQUIRE(to_string(l.to_span()) == "1");
+		lucas(l, 100);
+		REQUIRE(to_string(l.to_span()) == "792070839848372253127");
+	}
+
+	SECTION("Against the recurrences") {
+		auto f0 = make("0");
+		auto f1 = make("1");
+		auto l0 = make("2");
+		auto l1 = make("1");
+		for (auto n = 0zu; n <= 3000; ++n) {
+			if (n <= 400 || n % 127 == 0 || n == 3000) {
+				auto f = Integer{};
+				fibonacci(f, n);
+				REQUIRE(hex(f) == hex(f0));
+
+				auto a = Integer{};
+				auto b = Integer{};
+				fib2(a, b, n);
+				REQUIRE(hex(a) == hex(f0));
+				REQUIRE(hex(b) == hex(f1));
+
+				auto l = Integer{};
+				lucas(l, n);
+				REQUIRE(hex(l) == hex(l0));
+			}
+			auto f2 = naive_sum(f0, f1);
+			f0 = f1;
+			f1 = f2;
+			auto l2 = naive_sum(l0, l1);
+			l0 = l1;
+			l1 = l2;
+		}
+	}
+
+	SECTION("Doubling identities at large n") {
+		// F(2n) = F(n) L(n) and L(2n) = L(n)^2 - 2 (-1)^n
+		for (auto n : { 4096zu, 10001zu, 65537zu }) {
+			auto fn = Integer{};
+			auto ln = Integer{};
+			auto f2n = Integer{};
+			auto l2n = Integer{};
+			fibonacci(fn, n);
+			lucas(ln, n);
+			fibonacci(f2n, 2 * n);
+			lucas(l2n, 2 * n);
+			REQUIRE(hex(f2n) == hex(naive_product(fn, ln)));
+			REQUIRE(hex(l2n) == hex(naive_sum(naive_product(ln, ln), make(n & 1 ? "2" : "-2"))));
+		}
+	}
+}
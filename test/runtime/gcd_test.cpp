@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/gcd/gcd.hpp"
+#include "big_num/internal/gcd/gcdext.hpp"
+#include "big_num/internal/div/mod.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+// Built twice: with the default threshold, and with BIG_NUM_HGCD_THRESHOLD set to a
+// few blocks so the half-GCD handles the same operands the Lehmer path does here.
+
+namespace {
+	// Euclid by repeated `mod`, with a binary GCD once both fit in two blocks.
+	auto euclid(Integer const& a, Integer const& b) -> Integer {
+		auto x = from_blocks(std::vector<Integer::value_type>(a.begin(), a.end()));
+		auto y = from_blocks(std::vector<Integer::value_type>(b.begin(), b.end()));
+		while (!y.empty()) {
+			if (x.size() <= 2 && y.size() <= 2) {
+				auto const as_acc = [](Integer const& v) {
+					auto r = MachineConfig::acc_t{};
+					for (auto i = v.size(); i > 0; --i) r = (r << MachineConfig::bits) | v.data()[i - 1];
+					return r;
+				};
+				auto g = binary_gcd(as_acc(x), as_acc(y));
+				auto blocks = std::vector<Integer::value_type>{};
+				for (; g; g >>= MachineConfig::bits) blocks.push_back(static_cast<Integer::value_type>(g & MachineConfig::mask));
+				return from_blocks(blocks);
+			}
+			auto r = Integer{};
+			REQUIRE(mod(r, x, y));
+			x = y;
+			y = r;
+		}
+		return x;
+	}
+
+	auto check_gcd(Integer const& a, Integer const& b) -> void {
+		auto const expected = hex(euclid(a, b));
+		auto g = Integer{};
+		gcd(g, a, b);
+		REQUIRE(hex(g) == expected);
+
+		auto s = Integer{};
+		auto t = Integer{};
+		auto g2 = Integer{};
+		gcdext(g2, s, t, a, b);
+		REQUIRE(hex(g2) == expected);
+		REQUIRE(hex(naive_sum(naive_product(s, a), naive_product(t, b))) == expected);
+
+		// only one cofactor
+		auto s1 = Integer{};
+		gcdext(g2, &s1, nullptr, a, b);
+		REQUIRE(hex(g2) == expected);
+		REQUIRE(hex(s1) == hex(s));
+		auto t1 = Integer{};
+		gcdext(g2, nullptr, &t1, a, b);
+		REQUIRE(hex(g2) == expected);
+		REQUIRE(hex(t1) == hex(t));
+	}
+
+	// F(n) and F(n + 1): every quotient is one, the slowest case for Euclid.
+	auto fibonacci_pair(std::size_t n) -> std::pair<Integer, Integer> {
+		auto a = make("0");
+		auto b = make("1");
+		for (auto i = 0zu; i < n; ++i) {
+			auto c = naive_sum(a, b);
+			a = b;
+			b = c;
+		}
+		return { a, b };
+	}
+} // namespace
+
+TEST_CASE("Greatest common divisor", "[gcd:gcd]") {
+	SECTION("Known values") {
+		auto g = Integer{};
+		gcd(g, make("0"), make("0"));
+		REQUIRE(g.empty());
+		gcd(g, make("-12"), make("0"));
+		REQUIRE(to_string(g.to_span()) == "12");
+		gcd(g, make("-12"), make("-18"));
+		REQUIRE(to_string(g.to_span()) == "6");
+		// 2^127 - 1 and 2^89 - 1 are both prime
+		gcd(g, make("0x7fffffffffffffffffffffffffffffff"), make("618970019642690137449562111"));
+		REQUIRE(to_string(g.to_span()) == "1");
+		// gcd(2^a - 1, 2^b - 1) = 2^gcd(a, b) - 1
+		gcd(g, make("0xfffffffffffffffffffffffffffffffffffff"), make("0xffffffffffffffffffffffffffffffffffffffffffffffffff"));
+		REQUIRE(hex(g) == "0xf");
+	}
+
+	SECTION("Random operands with a common factor") {
+		auto g = std::mt19937_64(32);
+		for (auto gs : { 0zu, 1zu, 3zu, 10zu }) {
+			for (auto xs : { 1zu, 2zu, 5zu, 17zu, 40zu }) {
+				for (auto ys : { 1zu, xs, xs + 9 }) {
+					auto f = gs == 0 ? make("1") : random_integer(g, gs);
+					auto a = naive_product(f, random_integer(g, xs, g() & 1));
+					auto b = naive_product(f, random_integer(g, ys, g() & 1));
+					check_gcd(a, b);
+					check_gcd(b, a);
+				}
+			}
+		}
+	}
+
+	SECTION("Zero, equal operands and multiples") {
+		auto g = std::mt19937_64(321);
+		auto a = random_integer(g, 12);
+		check_gcd(a, make("0"));
+		check_gcd(make("0"), a);
+		check_gcd(a, a);
+		check_gcd(naive_product(a, random_integer(g, 7)), a);
+		check_gcd(random_integer(g, 30, false, true), random_integer(g, 29, false, true));
+	}
+
+	SECTION("Consecutive Fibonacci numbers") {
+		for (auto n : { 60zu, 300zu, 1500zu }) {
+			auto [a, b] = fibonacci_pair(n);
+			check_gcd(b, a);
+		}
+	}
+
+	SECTION("Second half-GCD split next to s") {
+		// With b just above 2^s the first half leaves n2 = bits(b), so the second split
+		// starts right at s; larger gaps take its truncated operands past the threshold.
+		auto g = std::mt19937_64(322);
+		for (auto blocks : { 8zu, 12zu, 20zu }) {
+			auto a = random_integer(g, blocks);
+			auto const n = a.to_span().trim_trailing_zeros().bits();
+			auto const s = n / 2 + 1;
+			for (auto d : { 1zu, 2zu, 3zu, 5zu, 31zu, 32zu, 33zu, 47zu, 48zu, 62zu, 93zu }) {
+				auto const nb = s + d;
+				if (nb >= n) continue;
+				auto v = std::vector<Integer::value_type>(MachineConfig::size(nb));
+				for (auto& x : v) x = static_cast<Integer::value_type>(g() & MachineConfig::mask);
+				auto const top = Integer::value_type{1} << ((nb - 1) % MachineConfig::bits);
+				v.back() = (v.back() & (top - 1)) | top;
+				auto const b = from_blocks(v);
+				check_gcd(a, b);
+				check_gcd(b, a);
+			}
+		}
+	}
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/integer_stream.hpp"
+#include "test_helpers.hpp"
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	// Hands out the text `chunk` characters at a time, then fails instead of ending.
+	struct FailingSource {
+		std::string_view text;
+		std::size_t chunk;
+
+		auto next() -> std::expected<std::string_view, std::string_view> {
+			if (text.empty()) return std::unexpected("Connection reset");
+			auto const n = std::min(chunk, text.size());
+			auto const res = text.substr(0, n);
+			text.remove_prefix(n);
+			return res;
+		}
+	};
+
+	// Same outcome as `parse_integer`: the same value or the same message.
+	auto check_same(std::expected<void, std::string_view> res, Integer const& out, std::string const& text, std::uint8_t radix_hint) -> void {
+		auto expected = Integer{};
+		auto const e = parse_integer(expected, text, radix_hint);
+		REQUIRE(res.has_value() == e.has_value());
+		if (!e) {
+			REQUIRE(res.error() == e.error());
+			return;
+		}
+		REQUIRE(hex(out) == hex(expected));
+	}
+
+	auto check_sources(std::string const& text, std::uint8_t radix_hint = 0) -> void {
+		auto out = Integer{};
+		auto memory = MemorySource(text);
+		check_same(parse_integer_stream(out, memory, radix_hint), out, text, radix_hint);
+
+		for (auto chunk : { 1zu, 2zu, 7zu, 4096zu }) {
+			auto in = std::istringstream(text);
+			auto source = IstreamSource(in, chunk);
+			out = Integer{};
+			check_same(parse_integer_stream(out, source, radix_hint), out, text, radix_hint);
+		}
+	}
+
+	auto with_separators(std::mt19937_64& g, std::string const& digits) -> std::string {
+		auto res = std::string{};
+		for (auto c : digits) {
+			res += c;
+			if (g() % 5 == 0) res += "_, "[g() % 3];
+		}
+		return res;
+	}
+
+	auto random_digits(std::mt19937_64& g, std::size_t n, unsigned radix) -> std::string {
+		auto res = std::string(1, "123456789abcdef"[g() % (radix - 1)]);
+		for (auto i = 1zu; i < n; ++i) res.push_back("0123456789abcdef"[g() % radix]);
+		return res;
+	}
+} // namespace
+
+TEST_CASE("Streaming parse", "[parse:stream]") {
+	SECTION("Same grammar as parse_integer") {
+		for (auto text : {
+			"", "   ", "+", "-", "0", "-0", "-000", "0_0", "00012", "42\n", " \t-1_234,567 890  \n",
+			"1 2 3", "12\n3", "12\n \n", "12a", "a12", "--1", "+-1", "0x", "0x_", "0xff", "-0XfF_ff",
+			"0x1g", "0b", "0b1011", "0B2", "0o777", "0o8", "-0x0000", "0x\n1",
+		}) {
+			check_sources(text);
+		}
+		check_sources("0xff", 16);
+		check_sources("0xff", 10);
+		check_sources("0b11", 8);
+		check_sources("12", 16);
+	}
+
+	SECTION("Long text across pieces and merges") {
+		auto g = std::mt19937_64(45);
+		struct Case {
+			unsigned radix;
+			std::string prefix;
+			std::vector<std::size_t> lengths;
+		};
+		auto const cases = {
+			// 4608 digits make one basecase piece for decimals
+			Case{ 10, "", { 1, 9, 100, 4607, 4608, 4609, 9216, 3 * 4608 + 1, 50001 } },
+			Case{ 16, "0x", { 1, 8, 5000, 30000 } },
+			Case{ 8, "0o", { 11, 20000 } },
+			Case{ 2, "0b", { 100, 70000 } },
+		};
+		for (auto const& c : cases) {
+			for (auto n : c.lengths) {
+				auto const digits = random_digits(g, n, c.radix);
+				check_sources(c.prefix + digits);
+				check_sources(" -" + c.prefix + with_separators(g, digits) + "\n");
+			}
+		}
+
+		// a bad digit far into the text
+		auto text = random_digits(g, 30000, 10);
+		text[25000] = 'x';
+		check_sources(text);
+	}
+
+	SECTION("Errors from the source") {
+		auto out = make("5");
+		for (auto chunk : { 1zu, 3zu, 100zu }) {
+			auto source = FailingSource{ "-123_456", chunk };
+			auto const res = parse_integer_stream(out, source);
+			REQUIRE(!res.has_value());
+			REQUIRE(res.error() == "Connection reset");
+		}
+	}
+
+	#ifdef BIG_NUM_HAS_FD_SOURCE
+	SECTION("Pipes and files") {
+		auto g = std::mt19937_64(451);
+		auto const text = "-" + random_digits(g, 20000, 10) + "\n";
+		auto expected = Integer{};
+		REQUIRE(parse_integer(expected, text).has_value());
+
+		for (auto chunk : { 1zu, 3zu, 1zu << 16 }) {
+			int fds[2];
+			REQUIRE(::pipe(fds) == 0);
+			auto out = Integer{};
+			{
+				// the pipe holds less than the text, so the writer waits on the reader
+				auto writer = std::jthread([&] {
+					for (auto s = std::string_view(text); !s.empty();) {
+						auto const n = ::write(fds[1], s.data(), std::min(s.size(), 1000zu));
+						if (n <= 0) break;
+						s.remove_prefix(static_cast<std::size_t>(n));
+					}
+					::close(fds[1]);
+				});
+				auto source = FdSource(fds[0], chunk);
+				REQUIRE(parse_integer_stream(out, source).has_value());
+			}
+			::close(fds[0]);
+			REQUIRE(hex(out) == hex(expected));
+		}
+
+		auto* file = std::tmpfile();
+		REQUIRE(file != nullptr);
+		REQUIRE(std::fwrite(text.data(), 1, text.size(), file) == text.size());
+		std::fflush(file);
+		std::rewind(file);
+		auto source = FdSource(::fileno(file));
+		auto out = Integer{};
+		REQUIRE(parse_integer_stream(out, source).has_value());
+		REQUIRE(hex(out) == hex(expected));
+		std::fclose(file);
+	}
+	#endif
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/mod/invert.hpp"
+#include "big_num/internal/gcd/gcd.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	// x is the inverse of a mod m: a * x = 1 (mod m) and 0 <= x < m.
+	auto check_inverse(Integer const& x, Integer const& a, Integer const& m) -> void {
+		REQUIRE(!x.is_neg());
+		REQUIRE(hex(naive_mod(x, m)) == hex(x));
+		auto p = naive_product(naive_mod(a, m), x);
+		p.set_neg(false);
+		auto r = naive_mod(p, m);
+		if (a.is_neg()) {
+			// (-a) * x = 1 means a * x = m - 1
+			REQUIRE(hex(naive_sum(r, make("1"))) == hex(m));
+		} else {
+			REQUIRE(hex(r) == "0x1");
+		}
+	}
+} // namespace
+
+TEST_CASE("Modular inverse", "[mod:invert]") {
+	SECTION("Known values") {
+		auto x = Integer{};
+		REQUIRE(invert(x, make("3"), make("7")));
+		REQUIRE(to_string(x.to_span()) == "5");
+		REQUIRE(invert(x, make("-3"), make("7")));
+		REQUIRE(to_string(x.to_span()) == "2");
+		REQUIRE(invert(x, make("10"), make("7")));
+		REQUIRE(to_string(x.to_span()) == "5");
+		// 2^-1 mod 2^127 - 1 is 2^126
+		REQUIRE(invert(x, make("2"), make("0x7fffffffffffffffffffffffffffffff")));
+		REQUIRE(hex(x) == "0x40000000000000000000000000000000");
+
+		REQUIRE(!invert(x, make("6"), make("9")));
+		REQUIRE(!invert(x, make("0"), make("9")));
+		REQUIRE(!invert(x, make("3"), make("0")));
+	}
+
+	SECTION("Random moduli") {
+		auto g = std::mt19937_64(33);
+		for (auto k : { 1zu, 2zu, 3zu, 8zu, 21zu }) {
+			for (auto odd : { true, false }) {
+				auto m = random_integer(g, k);
+				m.data()[0] = odd ? (m.data()[0] | 1) : (m.data()[0] & ~Integer::value_type{1});
+				if (m.to_span().trim_trailing_zeros().bits() < 2) continue;
+				for (auto as : { 1zu, k, 2 * k + 1 }) {
+					for (auto neg : { false, true }) {
+						auto const a = random_integer(g, as, neg);
+						auto x = Integer{};
+						auto d = Integer{};
+						gcd(d, a, m);
+						auto const ok = invert(x, a, m);
+						REQUIRE(ok == (hex(d) == "0x1"));
+						if (ok) check_inverse(x, a, m);
+					}
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Batch modular inverse", "[mod:invert_batch]") {
+	auto g = std::mt19937_64(331);
+	for (auto k : { 1zu, 4zu, 13zu }) {
+		auto m = random_integer(g, k);
+		m.data()[0] |= 1;
+		if (m.to_span().trim_trailing_zeros().bits() < 2) continue;
+
+		auto in = std::vector<Integer>{};
+		while (in.size() < 9) {
+			auto a = random_integer(g, 1 + in.size() % (2 * k + 1), in.size() % 3 == 0);
+			auto x = Integer{};
+			if (invert(x, a, m)) in.push_back(a);
+		}
+
+		auto out = std::vector<Integer>(in.size());
+		REQUIRE(invert_batch(out, in, m));
+		for (auto i = 0zu; i < in.size(); ++i) {
+			auto x = Integer{};
+			REQUIRE(invert(x, in[i], m));
+			REQUIRE(hex(out[i]) == hex(x));
+			check_inverse(out[i], in[i], m);
+		}
+
+		auto expected = std::vector<std::string>{};
+		for (auto const& x : out) expected.push_back(hex(x));
+
+		// out aliasing in
+		auto alias = std::vector<Integer>{};
+		for (auto const& a : in) alias.push_back(make(hex(a)));
+		REQUIRE(invert_batch(alias, alias, m));
+		for (auto i = 0zu; i < alias.size(); ++i) REQUIRE(hex(alias[i]) == expected[i]);
+
+		// a multiple of a factor of m makes the whole batch fail and leaves out alone
+		auto bad = std::vector<Integer>{};
+		for (auto const& a : in) bad.push_back(make(hex(a)));
+		bad.push_back(naive_product(m, make("3")));
+		auto untouched = std::vector<Integer>(bad.size());
+		for (auto& u : untouched) u = make("12345");
+		REQUIRE(!invert_batch(untouched, bad, m));
+		for (auto const& u : untouched) REQUIRE(to_string(u.to_span()) == "12345");
+	}
+}
+
+TEST_CASE("Batch modular inverse of powers of two", "[mod:invert_batch]") {
+	// The running products stay powers of two until they wrap around m, so their
+	// Barrett reductions see multiples of B^(k + 1).
+	auto g = std::mt19937_64(332);
+	for (auto k : { 2zu, 3zu, 6zu }) {
+		auto m = random_integer(g, k);
+		m.data()[0] |= 1;
+
+		auto in = std::vector<Integer>{};
+		for (auto i = 0zu; i < 9; ++i) {
+			auto blocks = std::vector<Integer::value_type>(1 + i % k, 0);
+			blocks.back() = Integer::value_type{1} << (7 * i % MachineConfig::bits);
+			in.push_back(from_blocks(blocks));
+		}
+
+		auto out = std::vector<Integer>(in.size());
+		REQUIRE(invert_batch(out, in, m));
+		for (auto i = 0zu; i < in.size(); ++i) {
+			auto x = Integer{};
+			REQUIRE(invert(x, in[i], m));
+			REQUIRE(hex(out[i]) == hex(x));
+			check_inverse(out[i], in[i], m);
+		}
+	}
+}
@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/div/mod.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+TEST_CASE("Remainder without quotient", "[div:mod]") {
+	SECTION("Known values") {
+		auto r = Integer{};
+		REQUIRE(mod(r, make("1606938044258990275541962092341162602522202993782792835301375"), make("1000000000000000000000000000057")));
+		REQUIRE(to_string(r.to_span()) == "567133999440548076900996043182");
+
+		REQUIRE(mod(r, make("-100"), make("7")));
+		REQUIRE(to_string(r.to_span()) == "-2");
+		REQUIRE(mod(r, make("100"), make("-7")));
+		REQUIRE(to_string(r.to_span()) == "2");
+		REQUIRE(mod(r, make("-98"), make("7")));
+		REQUIRE(r.empty());
+		REQUIRE(!r.is_neg());
+
+		REQUIRE(!mod(r, make("100"), make("0")));
+	}
+
+	SECTION("Against naive division") {
+		auto g = std::mt19937_64(29);
+		for (auto n : { 1zu, 2zu, 3zu, 5zu, 9zu, 24zu }) {
+			for (auto ones : { false, true }) {
+				auto den = random_integer(g, n, false, ones);
+				for (auto us : { 0zu, 1zu, n - 1, n, n + 1, 2 * n, 3 * n + 2 }) {
+					for (auto neg : { false, true }) {
+						auto num = random_integer(g, us, neg, ones);
+						auto r = Integer{};
+						REQUIRE(mod(r, num, den));
+						auto expected = naive_mod(num, den);
+						expected.set_neg(neg && !expected.empty());
+						REQUIRE(hex(r) == hex(expected));
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("Divisors with a small leading block") {
+		auto g = std::mt19937_64(291);
+		for (auto n : { 2zu, 4zu, 7zu }) {
+			auto den = random_integer(g, n);
+			den.data()[n - 1] = 1;
+			auto num = random_integer(g, 3 * n);
+			auto r = Integer{};
+			REQUIRE(mod(r, num, den));
+			REQUIRE(hex(r) == hex(naive_mod(num, den)));
+		}
+	}
+
+	SECTION("Span overload clears the extra blocks") {
+		auto g = std::mt19937_64(292);
+		auto den = random_integer(g, 6);
+		auto num = random_integer(g, 15);
+		auto out = std::vector<Integer::value_type>(9, 0x5a5a);
+		REQUIRE(mod(num_t(out.data(), out.size()), num.to_span(), den.to_span()));
+		REQUIRE(hex(const_num_t(out.data(), out.size())) == hex(naive_mod(num, den)));
+		REQUIRE(out[6] == 0);
+		REQUIRE(out[8] == 0);
+	}
+
+	SECTION("Output aliasing an input") {
+		auto g = std::mt19937_64(293);
+		for (auto n : { 1zu, 4zu, 11zu }) {
+			auto const blocks_num = random_integer(g, 2 * n + 1, true);
+			auto const blocks_den = random_integer(g, n);
+			auto const num_v = std::vector<Integer::value_type>(blocks_num.begin(), blocks_num.end());
+			auto const den_v = std::vector<Integer::value_type>(blocks_den.begin(), blocks_den.end());
+
+			auto expected = naive_mod(blocks_num, blocks_den);
+			expected.set_neg(!expected.empty());
+
+			auto x = from_blocks(num_v, true);
+			REQUIRE(mod(x, x, from_blocks(den_v)));
+			REQUIRE(hex(x) == hex(expected));
+
+			auto d = from_blocks(den_v);
+			REQUIRE(mod(d, from_blocks(num_v, true), d));
+			REQUIRE(hex(d) == hex(expected));
+		}
+	}
+}
+
+TEST_CASE("Remainder by a single block", "[div:mod_1]") {
+	auto g = std::mt19937_64(294);
+	auto const dens = std::vector<Integer::value_type>{
+		1, 2, 3, 7, 10, 1u << 16, 1000000007, MachineConfig::mask, MachineConfig::mask >> 1, (MachineConfig::mask >> 1) + 1
+	};
+	for (auto den : dens) {
+		for (auto us : { 0zu, 1zu, 2zu, 5zu, 30zu }) {
+			auto num = random_integer(g, us);
+			auto const expected = naive_mod(num, from_blocks(std::vector<Integer::value_type>{ den }));
+			auto const r = mod_1(num, den);
+			REQUIRE(hex(from_blocks(std::vector<Integer::value_type>{ r })) == hex(expected));
+		}
+	}
+}
@@ -0,0 +1,99 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/mod/montgomery.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	// k-block copy of a, which has to be below the modulus.
+	auto blocks_of(Integer const& a, std::size_t k) -> std::vector<Integer::value_type> {
+		auto res = std::vector<Integer::value_type>(k, 0);
+		std::copy(a.begin(), a.end(), res.begin());
+		return res;
+	}
+
+	auto span_of(std::vector<Integer::value_type>& v) -> num_t {
+		return num_t(v.data(), v.size());
+	}
+} // namespace
+
+TEST_CASE("Montgomery arithmetic", "[mod:montgomery]") {
+	SECTION("Products against naive reduction") {
+		auto g = std::mt19937_64(27);
+		for (auto k : { 1zu, 2zu, 3zu, 4zu, 7zu, 16zu, 33zu }) {
+			for (auto ones : { false, true }) {
+				auto m = random_integer(g, k, false, ones);
+				m.data()[0] |= 1;
+				auto ctx = MontgomeryContext(m.to_span());
+				REQUIRE(ctx.size() == k);
+
+				for (auto i = 0; i < 4; ++i) {
+					auto a = naive_mod(random_integer(g, k, false, ones), m);
+					auto b = naive_mod(random_integer(g, k), m);
+					auto am = blocks_of(a, k);
+					auto bm = blocks_of(b, k);
+					ctx.to_mont(span_of(am), span_of(am));
+					ctx.to_mont(span_of(bm), span_of(bm));
+
+					auto p = std::vector<Integer::value_type>(k);
+					ctx.mont_mul(span_of(p), span_of(am), span_of(bm));
+					ctx.from_mont(span_of(p), span_of(p));
+					REQUIRE(hex(span_of(p)) == hex(naive_mod(naive_product(a, b), m)));
+
+					ctx.mont_sqr(span_of(p), span_of(am));
+					ctx.from_mont(span_of(p), span_of(p));
+					REQUIRE(hex(span_of(p)) == hex(naive_mod(naive_product(a, a), m)));
+				}
+			}
+		}
+	}
+
+	SECTION("Zero, one and m - 1") {
+		auto g = std::mt19937_64(271);
+		auto m = random_integer(g, 5);
+		m.data()[0] |= 1;
+		auto const k = m.size();
+		auto ctx = MontgomeryContext(m.to_span());
+
+		// R mod m is one in Montgomery form
+		auto one = std::vector<Integer::value_type>(k);
+		ctx.from_mont(span_of(one), ctx.one());
+		REQUIRE(hex(span_of(one)) == "0x1");
+
+		auto mm1 = blocks_of(m, k);
+		mm1[0] -= 1;
+		auto x = mm1;
+		ctx.to_mont(span_of(x), span_of(x));
+		ctx.mont_sqr(span_of(x), span_of(x));
+		ctx.from_mont(span_of(x), span_of(x));
+		// (m - 1)^2 = 1 mod m
+		REQUIRE(hex(span_of(x)) == "0x1");
+
+		auto zero = std::vector<Integer::value_type>(k);
+		ctx.mont_mul(span_of(x), span_of(zero), span_of(mm1));
+		REQUIRE(hex(span_of(x)) == "0x0");
+	}
+
+	SECTION("Caller scratch") {
+		auto g = std::mt19937_64(272);
+		auto m = random_integer(g, 9);
+		m.data()[0] |= 1;
+		auto const k = m.size();
+		auto const ctx = MontgomeryContext(m.to_span());
+		auto scratch = std::vector<Integer::value_type>(ctx.scratch_size());
+		auto wide = std::vector<MontgomeryContext::acc_t>(ctx.wide_scratch_size());
+
+		auto a = naive_mod(random_integer(g, k), m);
+		auto b = naive_mod(random_integer(g, k), m);
+		auto am = blocks_of(a, k);
+		auto bm = blocks_of(b, k);
+		ctx.to_mont(span_of(am), span_of(am), span_of(scratch), wide);
+		ctx.to_mont(span_of(bm), span_of(bm), span_of(scratch), wide);
+		ctx.mont_mul(span_of(am), span_of(am), span_of(bm), span_of(scratch), wide);
+		ctx.from_mont(span_of(am), span_of(am), span_of(scratch));
+		REQUIRE(hex(span_of(am)) == hex(naive_mod(naive_product(a, b), m)));
+	}
+}
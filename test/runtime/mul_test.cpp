@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/mul/mul.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+// The Integer overloads add into `out`, so every product gets a fresh one.
+TEST_CASE("Multiplication tiers", "[mul:tiers]") {
+	constexpr auto naive_max = 1zu << MachineConfig::naive_mul_threshold;
+	constexpr auto karatsuba_max = 1zu << MachineConfig::karatsuba_threshold;
+
+	SECTION("All-ones operands carry through every sum") {
+		auto g = std::mt19937_64(37);
+		for (auto n : { naive_max + 1, 2 * naive_max + 3, 100zu, karatsuba_max, karatsuba_max + 1, karatsuba_max + 100 }) {
+			auto const a = random_integer(g, n, false, true);
+			auto r = Integer{};
+			mul(r, a, a);
+			REQUIRE(hex(r) == hex(naive_product(a, a)));
+
+			auto const b = random_integer(g, n - 1, true, true);
+			r = Integer{};
+			mul(r, a, b);
+			REQUIRE(hex(r) == hex(naive_product(a, b)));
+		}
+	}
+
+	SECTION("Unbalanced all-ones operands") {
+		auto g = std::mt19937_64(371);
+		for (auto n : { 40zu, 300zu, karatsuba_max + 50 }) {
+			for (auto m : { 2zu, n / 3, n / 2 + 1 }) {
+				auto const a = random_integer(g, n, false, true);
+				auto const b = random_integer(g, m, false, true);
+				auto r = Integer{};
+				mul(r, a, b);
+				REQUIRE(hex(r) == hex(naive_product(a, b)));
+				r = Integer{};
+				mul(r, b, a);
+				REQUIRE(hex(r) == hex(naive_product(a, b)));
+			}
+		}
+	}
+
+	SECTION("Karatsuba and Toom-3 called directly") {
+		auto g = std::mt19937_64(372);
+		for (auto n : { 6zu, 9zu, 24zu, 37zu, 64zu }) {
+			for (auto ones : { false, true }) {
+				for (auto m : { n, n - 1, n / 2 + 1 }) {
+					auto const a = random_integer(g, n, false, ones);
+					auto const b = random_integer(g, m, g() & 1, ones);
+					auto const expected = hex(naive_product(a, b));
+
+					auto r = Integer{};
+					karatsuba_mul(r, a, b);
+					REQUIRE(hex(r) == expected);
+					r = Integer{};
+					toom_cook_3(r, a, b);
+					REQUIRE(hex(r) == expected);
+				}
+			}
+		}
+	}
+
+	SECTION("Span overload against naive products") {
+		auto g = std::mt19937_64(373);
+		for (auto n : { 3zu, naive_max, naive_max + 5, 150zu, karatsuba_max + 9 }) {
+			auto const a = random_integer(g, n);
+			auto const b = random_integer(g, n);
+			auto out = std::vector<Integer::value_type>(2 * n, 0);
+			mul(num_t(out.data(), out.size()), a.to_span(), b.to_span());
+			REQUIRE(hex(const_num_t(out.data(), out.size())) == hex(naive_product(a, b)));
+		}
+	}
+}
@@ -0,0 +1,264 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/integer_parse.hpp"
+#include "test_helpers.hpp"
+#include <cstdint>
+#include <random>
+#include <string>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	// One multiply-add pass over the blocks per digit; digits are checked by the caller.
+	auto naive_parse(std::string_view digits, unsigned radix = 10, bool neg = false) -> Integer {
+		using acc_t = MachineConfig::acc_t;
+		auto v = std::vector<Integer::value_type>{};
+		for (auto ch : digits) {
+			auto c = acc_t{ static_cast<Integer::value_type>(ch <= '9' ? ch - '0' : ch - 'a' + 10) };
+			for (auto& b : v) {
+				auto const t = acc_t{b} * radix + c;
+				b = static_cast<Integer::value_type>(t & MachineConfig::mask);
+				c = t >> MachineConfig::bits;
+			}
+			if (c) v.push_back(static_cast<Integer::value_type>(c));
+		}
+		return from_blocks(v, neg);
+	}
+
+	auto random_digits(std::mt19937_64& g, std::size_t n, unsigned radix = 10) -> std::string {
+		auto res = std::string{};
+		for (auto i = 0zu; i < n; ++i) res.push_back("0123456789abcdef"[g() % radix]);
+		return res;
+	}
+} // namespace
+
+TEST_CASE("Decimal parsing", "[parse:parse_integer]") {
+	SECTION("Known values") {
+		auto x = Integer{};
+		REQUIRE(parse_integer(x, "0").has_value());
+		REQUIRE(x.empty());
+		REQUIRE(parse_integer(x, "-0").has_value());
+		REQUIRE(x.empty());
+		REQUIRE(!x.is_neg());
+		REQUIRE(parse_integer(x, "  +000000000000000000042 ").has_value());
+		REQUIRE(hex(x) == "0x2a");
+		REQUIRE(parse_integer(x, "-1_000,000 000").has_value());
+		REQUIRE(hex(x) == "-0x3b9aca00");
+		REQUIRE(parse_integer(x, "1606938044258990275541962092341162602522202993782792835301375").has_value());
+		REQUIRE(hex(x) == "0x" + std::string(50, 'f'));
+	}
+
+	SECTION("Lengths around the nine-digit chunks") {
+		auto g = std::mt19937_64(43);
+		for (auto n = 1zu; n <= 60; ++n) {
+			for (auto i = 0; i < 4; ++i) {
+				// all nines fill every chunk, random digits cover the rest
+				auto const digits = i == 0 ? std::string(n, '9') : random_digits(g, n);
+				auto x = Integer{};
+				REQUIRE(parse_integer(x, digits).has_value());
+				REQUIRE(hex(x) == hex(naive_parse(digits)));
+				REQUIRE(parse_integer(x, "-" + digits).has_value());
+				REQUIRE(hex(x) == hex(naive_parse(digits, 10, digits.find_first_not_of('0') != std::string::npos)));
+			}
+		}
+	}
+
+	SECTION("Leading zeros") {
+		auto g = std::mt19937_64(431);
+		for (auto zeros : { 1zu, 7zu, 8zu, 9zu, 17zu, 100zu }) {
+			auto const digits = random_digits(g, 25);
+			auto x = Integer{};
+			REQUIRE(parse_integer(x, std::string(zeros, '0') + digits).has_value());
+			REQUIRE(hex(x) == hex(naive_parse(digits)));
+			REQUIRE(parse_integer(x, std::string(zeros, '0')).has_value());
+			REQUIRE(x.empty());
+			REQUIRE(parse_integer(x, "-" + std::string(zeros, '0')).has_value());
+			REQUIRE(x.empty());
+			REQUIRE(!x.is_neg());
+		}
+	}
+
+	SECTION("Eight-digit words next to '/' and ':'") {
+		// '/' and ':' sit right below '0' and above '9', so they are the first bytes to slip through
+		auto g = std::mt19937_64(434);
+		for (auto d = '0'; d <= '9'; ++d) {
+			auto const word = std::string(8, d);
+			REQUIRE(detail::swar_is_decimal8(detail::swar_load8(word.data())));
+			REQUIRE(detail::swar_decimal8(detail::swar_load8(word.data())) == static_cast<std::uint32_t>(d - '0') * 11'111'111u);
+			for (auto lane = 0zu; lane < 8; ++lane) {
+				for (auto bad : { '/', ':' }) {
+					auto text = word;
+					text[lane] = bad;
+					REQUIRE(!detail::swar_is_decimal8(detail::swar_load8(text.data())));
+				}
+			}
+		}
+		for (auto i = 0; i < 200; ++i) {
+			auto const word = random_digits(g, 8);
+			REQUIRE(detail::swar_is_decimal8(detail::swar_load8(word.data())));
+			REQUIRE(detail::swar_decimal8(detail::swar_load8(word.data())) == std::stoul(word));
+		}
+
+		// a chunk of eight digits is one word; a ninth goes through the byte loop in front of it
+		for (auto n : { 8zu, 9zu }) {
+			for (auto d : { '0', '9' }) {
+				auto const digits = std::string(n, d);
+				auto v = MachineConfig::uint_t{};
+				REQUIRE(detail::parse_digit_chunk<10>(digits.data(), n, v));
+				REQUIRE(v == std::stoul(digits));
+				for (auto i = 0zu; i < n; ++i) {
+					for (auto bad : { '/', ':' }) {
+						auto text = digits;
+						text[i] = bad;
+						REQUIRE(!detail::parse_digit_chunk<10>(text.data(), n, v));
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("A bad character anywhere") {
+		auto g = std::mt19937_64(432);
+		// the neighbours of '0' and '9', letters, and bytes past ASCII
+		for (auto n : { 1zu, 8zu, 9zu, 10zu, 17zu, 18zu, 26zu }) {
+			auto const digits = random_digits(g, n);
+			for (auto i = 0zu; i < n; ++i) {
+				for (auto bad : { '/', ':', 'a', 'F', '.', '-', '\x80', '\xb9' }) {
+					auto text = "1" + digits;
+					text[i + 1] = bad;
+					auto x = make("12345");
+					auto const res = parse_integer(x, text);
+					REQUIRE(!res.has_value());
+					REQUIRE(res.error() == "Invalid decimal number");
+					REQUIRE(x.empty());
+				}
+			}
+		}
+	}
+
+	SECTION("Long text in both tiers") {
+		auto g = std::mt19937_64(433);
+		constexpr auto naive_max = MachineConfig::parse_naive_threshold;
+		for (auto n : { naive_max, naive_max + 1, 3 * naive_max + 5 }) {
+			auto const digits = random_digits(g, n);
+			auto x = Integer{};
+			REQUIRE(parse_integer(x, digits).has_value());
+			REQUIRE(hex(x) == hex(naive_parse(digits)));
+
+			// a bad digit in the lower half goes through the split too
+			auto text = digits;
+			text[n - n / 4] = 'x';
+			REQUIRE(!parse_integer(x, text).has_value());
+		}
+	}
+}
+
+TEST_CASE("Power-of-two radixes", "[parse:pow2]") {
+	struct Radix {
+		unsigned radix;
+		std::string prefix;
+		std::string error;
+		char bad;
+		std::size_t group;
+	};
+	auto const radixes = {
+		Radix{ 2, "0b", "Invalid binary number", '2', 8 },
+		Radix{ 8, "0o", "Invalid octal number", '8', 3 },
+		Radix{ 16, "0x", "Invalid hexadecimal number", 'g', 4 },
+	};
+
+	SECTION("Round trips around the eight-digit words") {
+		auto g = std::mt19937_64(44);
+		for (auto const& r : radixes) {
+			auto const radix = static_cast<std::uint8_t>(r.radix);
+			for (auto n = 1zu; n <= 70; ++n) {
+				auto const digits = random_digits(g, n, r.radix);
+				auto const expected = naive_parse(digits, r.radix);
+				auto x = Integer{};
+				REQUIRE(parse_integer(x, r.prefix + digits).has_value());
+				REQUIRE(hex(x) == hex(expected));
+				REQUIRE(parse_integer(x, "-" + r.prefix + digits, radix).has_value());
+				REQUIRE(hex(x) == hex(naive_parse(digits, r.radix, !expected.empty())));
+
+				auto const printed = naive_digits(expected, r.radix);
+				REQUIRE(to_string(expected.to_span(), radix) == printed);
+				REQUIRE(to_string(x.to_span(), radix, { .show_prefix = true }) == (expected.empty() ? "" : "-") + r.prefix + printed);
+			}
+		}
+	}
+
+	SECTION("Every block pattern") {
+		auto g = std::mt19937_64(441);
+		for (auto const& r : radixes) {
+			for (auto n : { 1zu, 2zu, 7zu, 31zu, 200zu }) {
+				for (auto ones : { false, true }) {
+					auto const x = random_integer(g, n, g() & 1, ones);
+					auto const text = to_string(x.to_span(), static_cast<std::uint8_t>(r.radix), { .show_prefix = true });
+					REQUIRE(text == (x.is_neg() ? "-" : "") + r.prefix + naive_digits(x, r.radix));
+					REQUIRE(hex(make(text)) == hex(x));
+				}
+			}
+		}
+	}
+
+	SECTION("Zero, case and separators") {
+		for (auto const& r : radixes) {
+			auto const radix = static_cast<std::uint8_t>(r.radix);
+			for (auto const& zero : { r.prefix + "0", "-" + r.prefix + "0000", r.prefix + "0_000" }) {
+				auto x = make("7");
+				REQUIRE(parse_integer(x, zero).has_value());
+				REQUIRE(x.empty());
+				REQUIRE(!x.is_neg());
+			}
+			REQUIRE(to_string(Integer{}.to_span(), radix) == "0");
+			REQUIRE(to_string(Integer{}.to_span(), radix, { .show_prefix = true }) == r.prefix + "0");
+
+			auto const digits = std::string(29, '1');
+			auto const x = naive_parse(digits, r.radix, true);
+			auto grouped = std::string{};
+			for (auto i = 0zu; i < digits.size(); ++i) {
+				if (i != 0 && (digits.size() - i) % r.group == 0) grouped += '_';
+				grouped += digits[i];
+			}
+			REQUIRE(to_string(x.to_span(), radix, { .show_prefix = true, .show_separator = true }) == "-" + r.prefix + grouped);
+			REQUIRE(hex(make("-" + r.prefix + grouped)) == hex(x));
+		}
+
+		REQUIRE(hex(make("0XDEAD_BEEF")) == "0xdeadbeef");
+		REQUIRE(hex(make("0xDeAdBeEf0123456789")) == "0xdeadbeef0123456789");
+		REQUIRE(hex(make("0B101")) == "0x5");
+		REQUIRE(hex(make("0O777")) == "0x1ff");
+	}
+
+	SECTION("Bad digits and prefixes") {
+		auto g = std::mt19937_64(442);
+		for (auto const& r : radixes) {
+			for (auto n : { 1zu, 8zu, 9zu, 17zu }) {
+				auto const digits = random_digits(g, n, r.radix);
+				for (auto i = 0zu; i < n; ++i) {
+					for (auto bad : { r.bad, '/', 'G', '\xff' }) {
+						auto text = r.prefix + digits;
+						text[r.prefix.size() + i] = bad;
+						auto x = make("12345");
+						auto const res = parse_integer(x, text);
+						REQUIRE(!res.has_value());
+						REQUIRE(res.error() == r.error);
+						REQUIRE(x.empty());
+					}
+				}
+			}
+
+			auto x = Integer{};
+			auto const missing = parse_integer(x, r.prefix);
+			REQUIRE(!missing.has_value());
+			REQUIRE(missing.error() == "Missing number after radix prefix: '" + r.prefix + "'");
+			auto const mismatch = parse_integer(x, r.prefix + "1", 10);
+			REQUIRE(!mismatch.has_value());
+			REQUIRE(mismatch.error() == "Radix mismatch: expected radix to be base-" + std::to_string(r.radix));
+		}
+		auto x = Integer{};
+		auto const res = parse_integer(x, "1234", 16);
+		REQUIRE(!res.has_value());
+		REQUIRE(res.error() == "Radix mismatch: expected radix to be base-10");
+	}
+}
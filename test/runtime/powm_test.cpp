@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/mod/powm.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	// base^e mod m, with a sign for negative bases, by e multiplications.
+	auto repeated_powm(Integer const& base, std::size_t e, Integer const& m) -> Integer {
+		auto b = naive_mod(base, m);
+		auto res = naive_mod(make("1"), m);
+		for (auto i = 0zu; i < e; ++i) res = naive_mod(naive_product(res, b), m);
+		if (base.is_neg() && (e & 1) && !res.empty()) {
+			auto t = from_blocks(std::vector<Integer::value_type>(m.begin(), m.end()));
+			abs_sub(t.to_span(), res.to_span());
+			t.remove_trailing_empty_blocks();
+			return t;
+		}
+		return res;
+	}
+
+	// Right-to-left binary powering out of the naive helpers, for exponents too long to repeat.
+	auto binary_powm(Integer const& base, Integer const& e, Integer const& m) -> Integer {
+		auto b = naive_mod(base, m);
+		auto res = naive_mod(make("1"), m);
+		for (auto i = 0zu; i < e.size() * MachineConfig::bits; ++i) {
+			if ((e.data()[i / MachineConfig::bits] >> (i % MachineConfig::bits)) & 1) {
+				res = naive_mod(naive_product(res, b), m);
+			}
+			b = naive_mod(naive_product(b, b), m);
+		}
+		return res;
+	}
+} // namespace
+
+TEST_CASE("Modular exponentiation", "[mod:powm]") {
+	SECTION("Known values") {
+		auto r = Integer{};
+		REQUIRE(powm(r, make("3"), make("1267650600228229401496703205383"), make("10000000000000000000000000000000000000000")));
+		REQUIRE(to_string(r.to_span()) == "5055438666117080445302769480627168217227");
+
+		REQUIRE(powm(r, make("-5"), make("12345"), make("618970019642690137449562111")));
+		REQUIRE(to_string(r.to_span()) == "452523126689595244053481476");
+
+		REQUIRE(powm(r, make("-2"), make("3"), make("7")));
+		REQUIRE(to_string(r.to_span()) == "6");
+
+		// Fermat: a^(p - 1) = 1 mod p for p = 2^127 - 1
+		auto p = make("0x7fffffffffffffffffffffffffffffff");
+		auto pm1 = make("0x7ffffffffffffffffffffffffffffffe");
+		REQUIRE(powm(r, make("123456789123456789"), pm1, p));
+		REQUIRE(to_string(r.to_span()) == "1");
+		REQUIRE(powm_sec(r, make("123456789123456789"), pm1, p));
+		REQUIRE(to_string(r.to_span()) == "1");
+	}
+
+	SECTION("Zero exponent, modulus one and zero modulus") {
+		auto r = Integer{};
+		REQUIRE(powm(r, make("12345"), make("0"), make("1000001")));
+		REQUIRE(to_string(r.to_span()) == "1");
+		REQUIRE(powm(r, make("12345"), make("0"), make("1000000")));
+		REQUIRE(to_string(r.to_span()) == "1");
+		REQUIRE(powm(r, make("12345"), make("99"), make("1")));
+		REQUIRE(r.empty());
+		REQUIRE(!powm(r, make("12345"), make("99"), make("0")));
+		REQUIRE(!powm_sec(r, make("12345"), make("99"), make("1000000")));
+	}
+
+	SECTION("Against repeated multiplication") {
+		auto g = std::mt19937_64(28);
+		for (auto k : { 1zu, 2zu, 3zu, 6zu, 13zu }) {
+			for (auto odd : { true, false }) {
+				auto m = random_integer(g, k);
+				m.data()[0] = odd ? (m.data()[0] | 1) : (m.data()[0] & ~Integer::value_type{1});
+				if (m.to_span().trim_trailing_zeros().bits() < 2) continue;
+				for (auto neg : { false, true }) {
+					auto base = random_integer(g, k + 1, neg);
+					for (auto e : { 1zu, 2zu, 3zu, 7zu, 30zu, 61zu }) {
+						auto r = Integer{};
+						REQUIRE(powm(r, base, make(std::to_string(e)), m));
+						auto const expected = hex(repeated_powm(base, e, m));
+						REQUIRE(hex(r) == expected);
+						if (odd) {
+							REQUIRE(powm_sec(r, base, make(std::to_string(e)), m));
+							REQUIRE(hex(r) == expected);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("Long exponents use every window size") {
+		auto g = std::mt19937_64(281);
+		for (auto eb : { 1zu, 2zu, 4zu, 9zu, 24zu }) {
+			for (auto odd : { true, false }) {
+				auto m = random_integer(g, 4);
+				m.data()[0] = odd ? (m.data()[0] | 1) : (m.data()[0] & ~Integer::value_type{1});
+				auto base = random_integer(g, 5);
+				auto e = random_integer(g, eb);
+				auto r = Integer{};
+				REQUIRE(powm(r, base, e, m));
+				auto const expected = hex(binary_powm(base, e, m));
+				REQUIRE(hex(r) == expected);
+				if (odd) {
+					REQUIRE(powm_sec(r, base, e, m));
+					REQUIRE(hex(r) == expected);
+				}
+			}
+		}
+	}
+
+	SECTION("Even moduli with power-of-two bases") {
+		// Until the power wraps around m it is a power of two, so the reduction sees multiples of B^(k + 1).
+		auto r = Integer{};
+		REQUIRE(powm(r, make("2"), make("128"), make("0x40000000000000000000002"))); // 2^90 + 2
+		REQUIRE(to_string(r.to_span()) == "1237940039285379725143310338");
+
+		auto g = std::mt19937_64(283);
+		for (auto k : { 2zu, 3zu, 6zu }) {
+			auto m = random_integer(g, k);
+			m.data()[0] &= ~Integer::value_type{1};
+			auto const span = MachineConfig::bits * (k + 1);
+			for (auto const base : { "2", "0x80000000", "0x4000000000000000" }) {
+				for (auto e : { span - 1, span, span + 1, 2 * span + 3 }) {
+					REQUIRE(powm(r, make(base), make(std::to_string(e)), m));
+					REQUIRE(hex(r) == hex(repeated_powm(make(base), e, m)));
+				}
+			}
+		}
+	}
+
+	SECTION("Montgomery form result") {
+		auto g = std::mt19937_64(282);
+		auto m = random_integer(g, 6);
+		m.data()[0] |= 1;
+		auto const k = m.size();
+		auto ctx = MontgomeryContext(m.to_span());
+		auto base = random_integer(g, 6);
+		auto e = random_integer(g, 3);
+
+		auto a = std::vector<Integer::value_type>(k);
+		auto b = std::vector<Integer::value_type>(k);
+		powm(num_t(a.data(), k), base.to_span(), e.to_span(), ctx);
+		powm_mont(num_t(b.data(), k), base.to_span(), e.to_span(), ctx);
+		ctx.from_mont(num_t(b.data(), k), const_num_t(b.data(), k));
+		REQUIRE(hex(const_num_t(a.data(), k)) == hex(const_num_t(b.data(), k)));
+	}
+
+	SECTION("Output aliasing an input") {
+		auto const base = "-0x123456789abcdef0123456789";
+		auto const exp = "0x10001";
+		for (auto const mod : { "0xfedcba9876543210fedcba987", "0xfedcba9876543210fedcba988" }) {
+			auto expected = Integer{};
+			REQUIRE(powm(expected, make(base), make(exp), make(mod)));
+
+			auto x = make(base);
+			REQUIRE(powm(x, x, make(exp), make(mod)));
+			REQUIRE(hex(x) == hex(expected));
+
+			auto e = make(exp);
+			REQUIRE(powm(e, make(base), e, make(mod)));
+			REQUIRE(hex(e) == hex(expected));
+
+			auto m = make(mod);
+			REQUIRE(powm(m, make(base), make(exp), m));
+			REQUIRE(hex(m) == hex(expected));
+		}
+	}
+}
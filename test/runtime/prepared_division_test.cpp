@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/div/prepared.hpp"
+#include "test_helpers.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	// r = |num| mod |den| and q * den = num - r, with the signs divmod gives them.
+	auto check_divmod(Integer const& num, Integer const& den, Integer const& q, Integer const& r) -> void {
+		auto expected_r = naive_mod(num, den);
+		expected_r.set_neg(num.is_neg() && !expected_r.empty());
+		REQUIRE(hex(r) == hex(expected_r));
+
+		auto rest = from_blocks(std::vector<Integer::value_type>(num.begin(), num.end()));
+		abs_sub(rest.to_span(), r.to_span());
+		rest.remove_trailing_empty_blocks();
+		auto qd = naive_product(from_blocks(std::vector<Integer::value_type>(q.begin(), q.end())), den);
+		qd.set_neg(false);
+		REQUIRE(hex(qd) == hex(rest));
+		REQUIRE(q.is_neg() == (num.is_neg() != den.is_neg() && !q.empty()));
+	}
+
+	auto random_dividends(std::mt19937_64& g, std::size_t n) -> std::vector<Integer> {
+		auto res = std::vector<Integer>{};
+		for (auto us : { 0zu, 1zu, n - 1, n, n + 1, 2 * n, 3 * n + 5 }) {
+			res.push_back(random_integer(g, us, g() & 1));
+		}
+		return res;
+	}
+} // namespace
+
+TEST_CASE("Prepared divisor", "[div:prepared]") {
+	SECTION("Known values") {
+		auto const d = PreparedDivisor(make("-1000000000000000000000000000057").to_span());
+		auto q = Integer{};
+		auto r = Integer{};
+		d.divmod(q, r, make("1606938044258990275541962092341162602522202993782792835301375"));
+		REQUIRE(to_string(q.to_span()) == "-1606938044258990275541962092249");
+		REQUIRE(to_string(r.to_span()) == "567133999440548076900996043182");
+	}
+
+	SECTION("Schoolbook and Barrett paths") {
+		auto g = std::mt19937_64(30);
+		auto const sizes = { 1zu, 2zu, 5zu, MachineConfig::div_barrett_threshold - 1, MachineConfig::div_barrett_threshold, MachineConfig::div_barrett_threshold + 7 };
+		for (auto n : sizes) {
+			for (auto ones : { false, true }) {
+				auto const den = random_integer(g, n, g() & 1, ones);
+				auto const d = PreparedDivisor(den.to_span());
+				REQUIRE(d.uses_barrett() == (n >= MachineConfig::div_barrett_threshold));
+				for (auto const& num : random_dividends(g, n)) {
+					auto q = Integer{};
+					auto r = Integer{};
+					d.divmod(q, r, num);
+					check_divmod(num, den, q, r);
+				}
+			}
+		}
+	}
+
+	SECTION("Output aliasing the dividend") {
+		auto g = std::mt19937_64(302);
+		for (auto n : { 1zu, 4zu, MachineConfig::div_barrett_threshold + 3 }) {
+			auto const den = random_integer(g, n, true);
+			auto const d = PreparedDivisor(den.to_span());
+			for (auto const& num : random_dividends(g, n)) {
+				auto q = Integer{};
+				auto r = Integer{};
+				d.divmod(q, r, num);
+				auto const num_v = std::vector<Integer::value_type>(num.begin(), num.end());
+
+				auto x = from_blocks(num_v, num.is_neg());
+				auto other = Integer{};
+				d.divmod(x, other, x);
+				REQUIRE(hex(x) == hex(q));
+				REQUIRE(hex(other) == hex(r));
+
+				x = from_blocks(num_v, num.is_neg());
+				d.divmod(other, x, x);
+				REQUIRE(hex(other) == hex(q));
+				REQUIRE(hex(x) == hex(r));
+
+				// the span overload, with each output over the dividend's blocks
+				auto const qs = d.quotient_size(num_v.size());
+				auto scratch = std::vector<Integer::value_type>(d.scratch_size(num_v.size()));
+				auto buf = num_v;
+				buf.resize(std::max({ buf.size(), qs, n }), 0);
+				auto out = std::vector<Integer::value_type>(std::max(qs, n), 0x5a5a);
+				d.divmod(num_t(buf.data(), qs), num_t(out.data(), n), const_num_t(buf.data(), num_v.size()), num_t(scratch.data(), scratch.size()));
+				REQUIRE(hex(const_num_t(buf.data(), qs)) == hex(from_blocks(std::vector<Integer::value_type>(q.begin(), q.end()))));
+				REQUIRE(hex(const_num_t(out.data(), n)) == hex(from_blocks(std::vector<Integer::value_type>(r.begin(), r.end()))));
+
+				std::fill(buf.begin(), buf.end(), 0);
+				std::copy(num_v.begin(), num_v.end(), buf.begin());
+				d.divmod(num_t(out.data(), qs), num_t(buf.data(), n), const_num_t(buf.data(), num_v.size()), num_t(scratch.data(), scratch.size()));
+				REQUIRE(hex(const_num_t(out.data(), qs)) == hex(from_blocks(std::vector<Integer::value_type>(q.begin(), q.end()))));
+				REQUIRE(hex(const_num_t(buf.data(), n)) == hex(from_blocks(std::vector<Integer::value_type>(r.begin(), r.end()))));
+			}
+		}
+	}
+}
+
+TEST_CASE("Batch division by a prepared divisor", "[div:prepared_batch]") {
+	auto g = std::mt19937_64(301);
+	for (auto n : { 3zu, MachineConfig::div_barrett_threshold + 1 }) {
+		auto const den = random_integer(g, n);
+		auto const d = PreparedDivisor(den.to_span());
+		auto nums = std::vector<Integer>{};
+		for (auto i = 0; i < 5; ++i) {
+			auto more = random_dividends(g, n);
+			nums.insert(nums.end(), more.begin(), more.end());
+		}
+
+		for (auto threads : { 1zu, 3zu, 0zu }) {
+			auto q = std::vector<Integer>(nums.size());
+			auto r = std::vector<Integer>(nums.size());
+			divmod_batch(q, r, nums, d, threads);
+			for (auto i = 0zu; i < nums.size(); ++i) check_divmod(nums[i], den, q[i], r[i]);
+
+			auto r2 = std::vector<Integer>(nums.size());
+			mod_batch(r2, nums, d, threads);
+			for (auto i = 0zu; i < nums.size(); ++i) REQUIRE(hex(r2[i]) == hex(r[i]));
+		}
+	}
+}
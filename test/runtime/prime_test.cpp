@@ -0,0 +1,132 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/prime/prime.hpp"
+#include "test_helpers.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	auto naive_is_prime(std::uint64_t n) -> bool {
+		if (n < 2) return false;
+		for (auto p = std::uint64_t{2}; p * p <= n; ++p) {
+			if (n % p == 0) return false;
+		}
+		return true;
+	}
+
+	// 2^p - 1
+	auto mersenne(std::size_t p) -> Integer {
+		auto s = std::string("0x");
+		if (p % 4) s += "137"[p % 4 - 1];
+		s.append(p / 4, 'f');
+		return make(s);
+	}
+
+	// Trial division up to 3 only, so everything from 9 up reaches Baillie-PSW.
+	auto const& bpsw_only_table() {
+		static auto const table = TrialDivisionTable(3);
+		return table;
+	}
+
+	auto bpsw_only(Integer const& n, std::size_t rounds = 0) -> bool {
+		return is_probable_prime(n.to_span(), rounds, bpsw_only_table());
+	}
+} // namespace
+
+TEST_CASE("Probable prime test", "[prime:bpsw]") {
+	SECTION("Known primes") {
+		for (auto const p : { "2", "3", "5", "7", "2147483647", "1000000007", "1000000000000000000000000000057" }) {
+			REQUIRE(is_probable_prime(make(p)));
+			REQUIRE(is_probable_prime(make(p), 5));
+		}
+		for (auto p : { 31zu, 61zu, 89zu, 107zu, 127zu, 521zu, 607zu }) {
+			REQUIRE(is_probable_prime(mersenne(p)));
+			REQUIRE(bpsw_only(mersenne(p), 3));
+		}
+		for (auto p : { 11zu, 23zu, 29zu, 37zu, 41zu, 43zu, 47zu, 53zu, 59zu, 67zu, 71zu, 73zu, 79zu, 83zu, 97zu, 101zu, 103zu, 109zu, 113zu }) {
+			REQUIRE(!is_probable_prime(mersenne(p)));
+			REQUIRE(!bpsw_only(mersenne(p)));
+		}
+	}
+
+	SECTION("Values below two and negatives") {
+		REQUIRE(!is_probable_prime(make("0")));
+		REQUIRE(!is_probable_prime(make("1")));
+		REQUIRE(!is_probable_prime(make("-7")));
+		REQUIRE(!is_probable_prime(make("4")));
+	}
+
+	SECTION("Carmichael numbers") {
+		for (auto const c : { "561", "1105", "1729", "2465", "2821", "6601", "8911", "41041", "825265", "321197185", "5394826801", "232250619601", "9746347772161" }) {
+			REQUIRE(!is_probable_prime(make(c)));
+			REQUIRE(!bpsw_only(make(c)));
+		}
+	}
+
+	SECTION("Strong pseudoprimes to base 2") {
+		for (auto const c : { "2047", "3277", "4033", "4681", "8321", "3215031751", "3825123056546413051", "318665857834031151167461" }) {
+			auto const n = make(c);
+			auto f = detail::PrimeField(n.to_span(), std::pmr::get_default_resource());
+			Integer::value_type two[1] = { 2 };
+			// the Miller-Rabin half of BPSW alone is fooled; the Lucas half is not
+			REQUIRE(detail::miller_rabin(f, const_num_t(two, 1), std::pmr::get_default_resource()));
+			REQUIRE(!is_probable_prime(n));
+			REQUIRE(!bpsw_only(n));
+		}
+	}
+
+	SECTION("Strong Lucas pseudoprimes") {
+		for (auto const c : { "5459", "5777", "10877", "16109", "18971", "22499", "24569", "25199", "40309", "58519" }) {
+			auto const n = make(c);
+			auto f = detail::PrimeField(n.to_span(), std::pmr::get_default_resource());
+			REQUIRE(detail::strong_lucas(f, std::pmr::get_default_resource()));
+			REQUIRE(!bpsw_only(n));
+		}
+	}
+
+	SECTION("Small values against trial division") {
+		for (auto n = std::uint64_t{}; n < 5000; ++n) {
+			auto const v = make(std::to_string(n));
+			REQUIRE(is_probable_prime(v) == naive_is_prime(n));
+			REQUIRE(bpsw_only(v) == naive_is_prime(n));
+		}
+	}
+
+	SECTION("Products of two large primes and perfect squares") {
+		auto const p = mersenne(89);
+		auto const q = mersenne(127);
+		REQUIRE(!is_probable_prime(naive_product(p, q)));
+		REQUIRE(!bpsw_only(naive_product(p, q), 4));
+		REQUIRE(!bpsw_only(naive_product(p, p)));
+		REQUIRE(!bpsw_only(naive_product(q, q)));
+	}
+}
+
+TEST_CASE("Probable primes in an interval", "[prime:interval]") {
+	SECTION("Small start against trial division") {
+		constexpr auto n = 3000zu;
+		for (auto threads : { 1zu, 4zu }) {
+			auto flags = std::vector<std::uint8_t>(n, 0x5a);
+			probable_primes_in(flags, make("0"), 0, threads);
+			for (auto i = 0zu; i < n; ++i) REQUIRE(flags[i] == (naive_is_prime(i) ? 1 : 0));
+		}
+	}
+
+	SECTION("Large start against single tests") {
+		auto const start = naive_sum(mersenne(127), make("-500"));
+		constexpr auto n = 1000zu;
+		auto expected = std::vector<bool>{};
+		for (auto i = 0zu; i < n; ++i) expected.push_back(is_probable_prime(naive_sum(start, make(std::to_string(i)))));
+		REQUIRE(expected[500]);
+
+		for (auto threads : { 1zu, 3zu, 0zu }) {
+			auto flags = std::vector<std::uint8_t>(n, 0x5a);
+			probable_primes_in(flags, start, 2, threads);
+			for (auto i = 0zu; i < n; ++i) REQUIRE(flags[i] == (expected[i] ? 1 : 0));
+		}
+	}
+}
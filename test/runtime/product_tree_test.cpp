@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/mod/product_tree.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+TEST_CASE("Product and remainder trees", "[mod:product_tree]") {
+	SECTION("Empty and single modulus") {
+		auto const none = ProductTree(std::span<Integer const>{});
+		REQUIRE(none.size() == 0);
+		REQUIRE(none.root().empty());
+
+		auto const m = std::vector<Integer>{ make("1000000000000000000000000000057") };
+		auto const one = ProductTree(m);
+		REQUIRE(one.size() == 1);
+		REQUIRE(hex(one.root()) == hex(m[0]));
+		auto out = std::vector<Integer>(1);
+		one.remainder_tree(out, make("-1606938044258990275541962092341162602522202993782792835301375"));
+		REQUIRE(to_string(out[0].to_span()) == "-567133999440548076900996043182");
+	}
+
+	SECTION("Root and nodes against naive products") {
+		auto g = std::mt19937_64(375);
+		// odd counts carry a node up unchanged
+		for (auto count : { 2zu, 3zu, 5zu, 8zu, 13zu }) {
+			auto moduli = std::vector<Integer>{};
+			auto expected = make("1");
+			for (auto i = 0zu; i < count; ++i) {
+				moduli.push_back(random_integer(g, 1 + i % 4, false, i % 3 == 0));
+				expected = naive_product(expected, moduli.back());
+			}
+			auto const tree = ProductTree(moduli);
+			REQUIRE(tree.size() == count);
+			REQUIRE(hex(tree.root()) == hex(expected));
+			auto const node = [&tree](std::size_t l, std::size_t i) {
+				auto const v = tree.node(l, i);
+				return from_blocks(std::span(v.data(), v.size()));
+			};
+			auto below = count;
+			for (auto l = 1zu; l < tree.levels(); ++l) {
+				for (auto i = 0zu; i < (below + 1) / 2; ++i) {
+					auto const expected_node = 2 * i + 1 < below
+						? naive_product(node(l - 1, 2 * i), node(l - 1, 2 * i + 1))
+						: node(l - 1, 2 * i);
+					REQUIRE(hex(node(l, i)) == hex(expected_node));
+				}
+				below = (below + 1) / 2;
+			}
+			REQUIRE(below == 1);
+		}
+	}
+
+	SECTION("Remainders against naive division") {
+		auto g = std::mt19937_64(376);
+		for (auto count : { 1zu, 4zu, 7zu, 32zu }) {
+			auto moduli = std::vector<Integer>{};
+			for (auto i = 0zu; i < count; ++i) moduli.push_back(random_integer(g, 1 + (i * 5) % 9));
+			auto const tree = ProductTree(moduli);
+
+			for (auto xs : { 0zu, 1zu, 6zu, 40zu, 200zu }) {
+				for (auto neg : { false, true }) {
+					auto const x = random_integer(g, xs, neg);
+					auto out = std::vector<Integer>(count);
+					tree.remainder_tree(out, x);
+					for (auto i = 0zu; i < count; ++i) {
+						auto expected = naive_mod(x, moduli[i]);
+						expected.set_neg(neg && !expected.empty());
+						REQUIRE(hex(out[i]) == hex(expected));
+					}
+				}
+			}
+		}
+	}
+
+	SECTION("Threads") {
+		auto g = std::mt19937_64(377);
+		auto moduli = std::vector<Integer>{};
+		for (auto i = 0zu; i < 45; ++i) moduli.push_back(random_integer(g, 1 + i % 6));
+		auto const x = random_integer(g, 150);
+
+		auto const serial = ProductTree(moduli);
+		auto expected = std::vector<Integer>(moduli.size());
+		serial.remainder_tree(expected, x);
+
+		for (auto threads : { 2zu, 5zu, 0zu }) {
+			auto const tree = ProductTree(moduli, threads);
+			REQUIRE(hex(tree.root()) == hex(serial.root()));
+			auto out = std::vector<Integer>(moduli.size());
+			tree.remainder_tree(out, x, threads);
+			for (auto i = 0zu; i < out.size(); ++i) REQUIRE(hex(out[i]) == hex(expected[i]));
+		}
+	}
+}
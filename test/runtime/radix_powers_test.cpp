@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/radix_powers.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	auto naive_pow(std::size_t radix, std::size_t e) -> Integer {
+		auto const r = make(std::to_string(radix));
+		auto res = make("1");
+		for (auto i = 0zu; i < e; ++i) res = naive_product(res, r);
+		return res;
+	}
+} // namespace
+
+TEST_CASE("Radix power cache", "[parse:radix_powers]") {
+	SECTION("Chunks") {
+		REQUIRE(detail::radix_chunk_digits(10) == 9);
+		REQUIRE(detail::radix_chunk(10) == 1'000'000'000u);
+		REQUIRE(detail::radix_chunk_digits(16) == 7);
+		REQUIRE(detail::radix_chunk(16) == 1u << 28);
+		REQUIRE(detail::radix_chunk_digits(2) == 30);
+		REQUIRE(detail::radix_chunk_digits(7) == 11);
+		REQUIRE(detail::radix_chunk(7) == 1'977'326'743u);
+	}
+
+	SECTION("Entries are the repeated squares") {
+		auto& cache = detail::radix_power_cache<7>();
+		auto const n = cache.ensure(6);
+		REQUIRE(n >= 1);
+		for (auto k = 0zu; k < n; ++k) {
+			REQUIRE(cache[k].digits() == 11 << k);
+			REQUIRE(hex(from_blocks(cache[k].power())) == hex(naive_pow(7, cache[k].digits())));
+			// published entries never move
+			REQUIRE(&cache[k] == &detail::radix_power_cache<7>()[k]);
+		}
+	}
+
+	SECTION("Growth stops at the bound") {
+		auto& cache = detail::radix_power_cache<10>();
+		if (MachineConfig::radix_cache_blocks <= 4096) {
+			REQUIRE(cache.ensure(detail::RadixPowerCache::max_entries - 1) < detail::RadixPowerCache::max_entries);
+		}
+		auto blocks = 0zu;
+		for (auto k = 0zu; k < cache.size(); ++k) blocks += cache[k].power().size();
+		REQUIRE(blocks <= MachineConfig::radix_cache_blocks);
+	}
+
+	SECTION("Powers from a table, past the cache too") {
+		auto table = detail::RadixPowerTable<10>();
+		for (auto digits : { 1zu, 9zu, 18zu, 100zu, 9zu << 6, 1000zu, 9zu << 9, 5000zu }) {
+			auto buf = detail::block_vec_t{};
+			auto const p = table.power_of(buf, digits);
+			REQUIRE(hex(from_blocks(p)) == hex(make("1" + std::string(digits, '0'))));
+		}
+
+		auto const k = table.split_index_digits(1000);
+		REQUIRE(table[k].digits() * 2 <= 1000);
+		REQUIRE(table[k].digits() * 4 > 1000);
+		auto const b = table.split_index_blocks(100);
+		REQUIRE(table[b].power().size() * 2 <= 100);
+	}
+
+	SECTION("Concurrent growth and divisors") {
+		// a radix nothing else uses, so the threads race on a cache that starts small
+		auto& cache = detail::radix_power_cache<13>();
+		auto powers = std::vector<std::string>(8);
+		auto divisors = std::vector<PreparedDivisor const*>(8);
+		{
+			auto workers = std::vector<std::jthread>{};
+			for (auto i = 0zu; i < powers.size(); ++i) {
+				workers.emplace_back([&cache, &powers, &divisors, i] {
+					auto const n = cache.ensure(5);
+					auto const& e = cache[std::min(n - 1, 5zu)];
+					divisors[i] = &e.divisor();
+					auto const p = e.power();
+					powers[i] = std::string(reinterpret_cast<char const*>(p.data()), p.size_bytes());
+				});
+			}
+		}
+		for (auto i = 1zu; i < powers.size(); ++i) {
+			REQUIRE(powers[i] == powers[0]);
+			REQUIRE(divisors[i] == divisors[0]);
+		}
+		auto const& e = cache[std::min(cache.size() - 1, 5zu)];
+		REQUIRE(hex(from_blocks(e.power())) == hex(naive_pow(13, e.digits())));
+		REQUIRE(divisors[0]->size() == e.power().size());
+	}
+
+	SECTION("Conversions share the cache") {
+		// whatever the cache holds, results do not depend on what ran before
+		auto g = std::mt19937_64(42);
+		for (auto n : { 40zu, 300zu, 700zu }) {
+			auto const x = random_integer(g, n);
+			auto const text = naive_digits(x);
+			for (auto i = 0; i < 2; ++i) {
+				REQUIRE(to_string(x.to_span()) == text);
+				REQUIRE(hex(make(text)) == hex(x));
+			}
+		}
+	}
+}
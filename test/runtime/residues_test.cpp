@@ -0,0 +1,54 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/mod/residues.hpp"
+#include "big_num/internal/div/mod.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+TEST_CASE("Residues by many moduli", "[mod:residues]") {
+	SECTION("Known values") {
+		auto const num = make("1606938044258990275541962092341162602522202993782792835301375"); // 2^200 - 1
+		auto const moduli = std::vector<Integer::value_type>{ 1, 2, 3, 7, 1000000007, MachineConfig::mask };
+		auto out = std::vector<Integer::value_type>(moduli.size());
+		residues(out, num, moduli);
+		REQUIRE(out == std::vector<Integer::value_type>{ 0, 1, 0, 3, 499445071, 16383 });
+	}
+
+	SECTION("Against mod_1 and naive division") {
+		auto g = std::mt19937_64(31);
+		// odd counts leave a tail after the vector lanes
+		for (auto np : { 1zu, 3zu, 8zu, 13zu, 64zu }) {
+			auto moduli = std::vector<Integer::value_type>(np);
+			for (auto& p : moduli) p = static_cast<Integer::value_type>(g() & MachineConfig::mask) | 1;
+			moduli[0] = MachineConfig::mask;
+			auto const table = ResidueTable(moduli);
+
+			for (auto us : { 0zu, 1zu, 7zu, 8zu, 9zu, 16zu, 45zu }) {
+				for (auto ones : { false, true }) {
+					auto const num = random_integer(g, us, false, ones);
+					auto out = std::vector<Integer::value_type>(np, 0x5a5a);
+					residues(out, num, table);
+					for (auto i = 0zu; i < np; ++i) {
+						REQUIRE(out[i] == mod_1(num, moduli[i]));
+					}
+					auto const expected = naive_mod(num, from_blocks(std::vector<Integer::value_type>{ moduli[np - 1] }));
+					REQUIRE(hex(from_blocks(std::vector<Integer::value_type>{ out[np - 1] })) == hex(expected));
+				}
+			}
+		}
+	}
+
+	SECTION("Sign is ignored") {
+		auto g = std::mt19937_64(311);
+		auto const moduli = std::vector<Integer::value_type>{ 3, 97, 65537 };
+		auto const num = random_integer(g, 20, true);
+		auto out = std::vector<Integer::value_type>(moduli.size());
+		residues(out, num, moduli);
+		for (auto i = 0zu; i < moduli.size(); ++i) {
+			REQUIRE(out[i] == mod_1(num, moduli[i]));
+		}
+	}
+}
@@ -0,0 +1,190 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/root/sqrt.hpp"
+#include "big_num/internal/root/root.hpp"
+#include "test_helpers.hpp"
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	auto naive_pow(Integer const& x, std::size_t k) -> Integer {
+		auto res = make("1");
+		for (auto i = 0zu; i < k; ++i) res = naive_product(res, x);
+		return res;
+	}
+
+	// a < b
+	auto is_below(Integer const& a, Integer const& b) -> bool {
+		auto nb = make(hex(b));
+		nb.set_neg(!nb.empty());
+		auto const d = naive_sum(a, nb);
+		return d.is_neg();
+	}
+
+	// x^k <= |a| < (x + 1)^k
+	auto check_root(Integer const& x, Integer const& a, std::size_t k) -> void {
+		auto const mag = make(hex(a.to_span().abs()));
+		auto const mx = make(hex(x.to_span().abs()));
+		REQUIRE(!is_below(mag, naive_pow(mx, k)));
+		REQUIRE(is_below(mag, naive_pow(naive_sum(mx, make("1")), k)));
+	}
+} // namespace
+
+TEST_CASE("Integer square root", "[root:sqrt]") {
+	SECTION("Known values") {
+		auto s = Integer{};
+		auto r = Integer{};
+		REQUIRE(!isqrt_rem(s, r, make("1606938044258990275541962092341162602522202993782792835301375")));
+		REQUIRE(to_string(s.to_span()) == "1267650600228229401496703205375");
+		REQUIRE(to_string(r.to_span()) == "2535301200456458802993406410750");
+
+		REQUIRE(isqrt_rem(s, r, make("10000000000000000000000000000000000000000")));
+		REQUIRE(to_string(s.to_span()) == "100000000000000000000");
+		REQUIRE(r.empty());
+
+		REQUIRE(isqrt_rem(s, r, make("0")));
+		REQUIRE(s.empty());
+		REQUIRE(r.empty());
+		REQUIRE(isqrt_rem(s, r, make("1")));
+		REQUIRE(to_string(s.to_span()) == "1");
+	}
+
+	SECTION("Against s^2 + r") {
+		auto g = std::mt19937_64(34);
+		for (auto n : { 1zu, 2zu, 3zu, 4zu, 5zu, 8zu, 15zu, 16zu, 33zu, 70zu }) {
+			for (auto ones : { false, true }) {
+				auto const a = random_integer(g, n, false, ones);
+				auto s = Integer{};
+				auto r = Integer{};
+				auto const exact = isqrt_rem(s, r, a);
+				REQUIRE(hex(naive_sum(naive_product(s, s), r)) == hex(a));
+				// r <= 2s, so (s + 1)^2 > a
+				REQUIRE(!is_below(naive_sum(s, s), r));
+				REQUIRE(exact == r.empty());
+
+				// span overload at the documented sizes
+				auto os = std::vector<Integer::value_type>((n + 1) / 2, 0x5a5a);
+				auto orr = std::vector<Integer::value_type>(n / 2 + 1, 0x5a5a);
+				REQUIRE(isqrt_rem(num_t(os.data(), os.size()), num_t(orr.data(), orr.size()), a.to_span()) == exact);
+				REQUIRE(hex(const_num_t(os.data(), os.size())) == hex(s));
+				REQUIRE(hex(const_num_t(orr.data(), orr.size())) == hex(r));
+			}
+		}
+	}
+
+	SECTION("Divisors past the Barrett division threshold") {
+		auto g = std::mt19937_64(343);
+		auto const n = 4 * MachineConfig::div_barrett_threshold + 9;
+		auto const a = random_integer(g, n);
+		auto s = Integer{};
+		auto r = Integer{};
+		isqrt_rem(s, r, a);
+		REQUIRE(hex(naive_sum(naive_product(s, s), r)) == hex(a));
+		REQUIRE(!is_below(naive_sum(s, s), r));
+
+		auto const x = random_integer(g, 2 * MachineConfig::div_barrett_threshold + 3);
+		REQUIRE(isqrt_rem(s, r, naive_product(x, x)));
+		REQUIRE(hex(s) == hex(x));
+	}
+
+	SECTION("Perfect squares and their neighbours") {
+		auto g = std::mt19937_64(341);
+		for (auto n : { 1zu, 2zu, 7zu, 20zu }) {
+			auto const x = random_integer(g, n);
+			auto const sq = naive_product(x, x);
+			auto s = Integer{};
+			auto r = Integer{};
+			REQUIRE(isqrt_rem(s, r, sq));
+			REQUIRE(hex(s) == hex(x));
+			REQUIRE(r.empty());
+
+			auto m1 = make("-1");
+			REQUIRE(!isqrt_rem(s, r, naive_sum(sq, m1)));
+			REQUIRE(hex(naive_sum(s, make("1"))) == hex(x));
+		}
+	}
+}
+
+TEST_CASE("Integer k-th root", "[root:iroot]") {
+	SECTION("Known values") {
+		auto x = Integer{};
+		auto const a = make("1606938044258990275541962092341162602522202993782792835301375");
+		REQUIRE(!iroot(x, a, 3));
+		REQUIRE(to_string(x.to_span()) == "117129523791978766508");
+		REQUIRE(!iroot(x, a, 7));
+		REQUIRE(to_string(x.to_span()) == "398893554");
+		REQUIRE(iroot(x, make("1" + std::string(100, '0')), 5));
+		REQUIRE(to_string(x.to_span()) == "100000000000000000000");
+		REQUIRE(iroot(x, make("-27"), 3));
+		REQUIRE(to_string(x.to_span()) == "-3");
+		REQUIRE(iroot(x, a, 1));
+		REQUIRE(hex(x) == hex(a));
+		REQUIRE(!iroot(x, a, 300));
+		REQUIRE(to_string(x.to_span()) == "1");
+	}
+
+	SECTION("Against x^k") {
+		auto g = std::mt19937_64(342);
+		for (auto k : { 2zu, 3zu, 4zu, 5zu, 11zu, 64zu }) {
+			for (auto n : { 1zu, 2zu, 3zu, 9zu, 25zu }) {
+				auto const a = random_integer(g, n, (k & 1) && (g() & 1));
+				auto x = Integer{};
+				auto const exact = iroot(x, a, k);
+				check_root(x, a, k);
+				REQUIRE(x.is_neg() == (a.is_neg() && !x.empty()));
+				auto p = naive_pow(x, k);
+				p.set_neg(false);
+				REQUIRE(exact == (hex(p) == hex(a.to_span().abs())));
+			}
+		}
+	}
+
+	SECTION("Divisors past the Barrett division threshold") {
+		// x^(k - 1) has at least div_barrett_threshold blocks
+		auto g = std::mt19937_64(344);
+		for (auto k : { 3zu, 4zu }) {
+			auto const a = random_integer(g, 2 * MachineConfig::div_barrett_threshold + 7);
+			auto x = Integer{};
+			iroot(x, a, k);
+			check_root(x, a, k);
+		}
+	}
+
+	SECTION("Perfect powers") {
+		auto g = std::mt19937_64(343);
+		for (auto k : { 3zu, 5zu, 8zu }) {
+			for (auto n : { 1zu, 3zu, 6zu }) {
+				auto const r = random_integer(g, n);
+				auto x = Integer{};
+				REQUIRE(iroot(x, naive_pow(r, k), k));
+				REQUIRE(hex(x) == hex(r));
+			}
+		}
+	}
+
+	SECTION("k at or past the bit length") {
+		auto x = Integer{};
+		REQUIRE(!iroot(x, make("5"), 16'000'000));
+		REQUIRE(to_string(x.to_span()) == "1");
+		REQUIRE(iroot(x, make("1"), 16'000'000));
+		REQUIRE(to_string(x.to_span()) == "1");
+		REQUIRE(iroot(x, make("-1"), 16'000'001));
+		REQUIRE(to_string(x.to_span()) == "-1");
+		REQUIRE(!iroot(x, make("-5"), 16'000'001));
+		REQUIRE(to_string(x.to_span()) == "-1");
+
+		// 2^k - 1 has k bits and root 1; 2^k has k + 1 bits and root 2
+		for (auto k : { 3zu, 31zu, 62zu, 200zu }) {
+			auto const all_ones = make("0b" + std::string(k, '1'));
+			REQUIRE(!iroot(x, all_ones, k));
+			REQUIRE(to_string(x.to_span()) == "1");
+			REQUIRE(iroot(x, make("0b1" + std::string(k, '0')), k));
+			REQUIRE(to_string(x.to_span()) == "2");
+			REQUIRE(!iroot(x, all_ones, 100 * k));
+			REQUIRE(to_string(x.to_span()) == "1");
+		}
+	}
+}
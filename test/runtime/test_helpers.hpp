@@ -0,0 +1,170 @@
+#ifndef AMT_BIG_NUM_TEST_RUNTIME_TEST_HELPERS_HPP
+#define AMT_BIG_NUM_TEST_RUNTIME_TEST_HELPERS_HPP
+
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/integer.hpp"
+#include "big_num/internal/integer_parse.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace big_num::test {
+	using namespace big_num::internal;
+
+	inline auto make(std::string_view text) -> Integer {
+		auto res = Integer{};
+		auto err = parse_integer(res, text);
+		REQUIRE(err.has_value());
+		return res;
+	}
+
+	inline auto from_blocks(std::span<Integer::value_type const> blocks, bool neg = false) -> Integer {
+		auto res = Integer{};
+		res.resize(blocks.size() * MachineConfig::bits);
+		std::copy(blocks.begin(), blocks.end(), res.data());
+		res.remove_trailing_empty_blocks();
+		res.set_neg(neg && !res.empty());
+		return res;
+	}
+
+	// Hex text, so a mismatch shows which blocks differ.
+	inline auto hex(const_num_t const& a) -> std::string {
+		auto const t = a.trim_trailing_zeros();
+		return to_string(const_num_t(t.data(), t.size(), a.is_neg()), 16, { .show_prefix = true });
+	}
+
+	inline auto hex(Integer const& a) -> std::string {
+		return hex(a.to_span());
+	}
+
+	// Exactly `blocks` blocks; `ones` makes every block all ones, the worst case for carries.
+	inline auto random_integer(
+		std::mt19937_64& g,
+		std::size_t blocks,
+		bool neg = false,
+		bool ones = false
+	) -> Integer {
+		auto v = std::vector<Integer::value_type>(blocks);
+		for (auto& b: v) {
+			b = ones ? MachineConfig::mask : static_cast<Integer::value_type>(g() & MachineConfig::mask);
+		}
+		if (!v.empty() && v.back() == 0) v.back() = 1;
+		return from_blocks(v, neg);
+	}
+
+	// |a| mod |m| one bit at a time; slow, but shares no code with the library.
+	inline auto naive_mod(Integer const& a, Integer const& m) -> Integer {
+		using acc_t = MachineConfig::acc_t;
+		auto const ms = m.to_span().trim_trailing_zeros();
+		REQUIRE(!ms.empty());
+		auto const n = ms.size();
+		auto r = std::vector<Integer::value_type>(n + 1, 0);
+
+		auto const geq = [&] {
+			if (r[n]) return true;
+			for (auto i = n; i > 0; --i) {
+				if (r[i - 1] != ms[i - 1]) return r[i - 1] > ms[i - 1];
+			}
+			return true;
+		};
+
+		for (auto i = a.size() * MachineConfig::bits; i > 0; --i) {
+			auto const j = i - 1;
+			auto c = static_cast<Integer::value_type>((a.data()[j / MachineConfig::bits] >> (j % MachineConfig::bits)) & 1);
+			for (auto& b: r) {
+				auto const t = (b << 1) | c;
+				c = t >> MachineConfig::bits;
+				b = t & MachineConfig::mask;
+			}
+			if (!geq()) continue;
+			auto borrow = acc_t{};
+			for (auto k = 0zu; k <= n; ++k) {
+				auto const d = acc_t{r[k]} - (k < n ? ms[k] : 0) - borrow;
+				r[k] = static_cast<Integer::value_type>(d & MachineConfig::mask);
+				borrow = (d >> MachineConfig::bits) & 1;
+			}
+		}
+		return from_blocks(r);
+	}
+
+	// Schoolbook product, one block at a time.
+	inline auto naive_product(Integer const& a, Integer const& b) -> Integer {
+		using acc_t = MachineConfig::acc_t;
+		auto res = std::vector<Integer::value_type>(a.size() + b.size() + 1, 0);
+		for (auto i = 0zu; i < a.size(); ++i) {
+			auto c = acc_t{};
+			for (auto j = 0zu; j < b.size(); ++j) {
+				auto const t = acc_t{a.data()[i]} * b.data()[j] + res[i + j] + c;
+				res[i + j] = static_cast<Integer::value_type>(t & MachineConfig::mask);
+				c = t >> MachineConfig::bits;
+			}
+			for (auto k = i + b.size(); c; ++k) {
+				auto const t = acc_t{res[k]} + c;
+				res[k] = static_cast<Integer::value_type>(t & MachineConfig::mask);
+				c = t >> MachineConfig::bits;
+			}
+		}
+		return from_blocks(res, a.is_neg() != b.is_neg());
+	}
+
+	// Signed sum, by magnitude compare and add or subtract.
+	inline auto naive_sum(Integer const& a, Integer const& b) -> Integer {
+		using acc_t = MachineConfig::acc_t;
+		auto const n = std::max(a.size(), b.size()) + 1;
+		auto x = std::vector<Integer::value_type>(n, 0);
+		auto y = std::vector<Integer::value_type>(n, 0);
+		std::copy(a.begin(), a.end(), x.begin());
+		std::copy(b.begin(), b.end(), y.begin());
+		auto neg = a.is_neg();
+
+		if (a.is_neg() == b.is_neg()) {
+			auto c = acc_t{};
+			for (auto i = 0zu; i < n; ++i) {
+				auto const t = acc_t{x[i]} + y[i] + c;
+				x[i] = static_cast<Integer::value_type>(t & MachineConfig::mask);
+				c = t >> MachineConfig::bits;
+			}
+			return from_blocks(x, neg);
+		}
+
+		if (std::lexicographical_compare(x.rbegin(), x.rend(), y.rbegin(), y.rend())) {
+			std::swap(x, y);
+			neg = b.is_neg();
+		}
+		auto borrow = acc_t{};
+		for (auto i = 0zu; i < n; ++i) {
+			auto const d = acc_t{x[i]} - y[i] - borrow;
+			x[i] = static_cast<Integer::value_type>(d & MachineConfig::mask);
+			borrow = (d >> MachineConfig::bits) & 1;
+		}
+		return from_blocks(x, neg);
+	}
+
+	// Digits of |a|, most significant first, by dividing out one digit at a time.
+	inline auto naive_digits(Integer const& a, unsigned radix = 10) -> std::string {
+		using acc_t = MachineConfig::acc_t;
+		auto v = std::vector<Integer::value_type>(a.begin(), a.end());
+		while (!v.empty() && v.back() == 0) v.pop_back();
+		if (v.empty()) return "0";
+
+		auto res = std::string{};
+		while (!v.empty()) {
+			auto r = acc_t{};
+			for (auto i = v.size(); i > 0; --i) {
+				auto const t = (r << MachineConfig::bits) | v[i - 1];
+				v[i - 1] = static_cast<Integer::value_type>(t / radix);
+				r = t % radix;
+			}
+			res.push_back("0123456789abcdef"[r]);
+			while (!v.empty() && v.back() == 0) v.pop_back();
+		}
+		std::reverse(res.begin(), res.end());
+		return res;
+	}
+} // namespace big_num::test
+
+#endif // AMT_BIG_NUM_TEST_RUNTIME_TEST_HELPERS_HPP
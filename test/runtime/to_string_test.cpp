@@ -0,0 +1,123 @@
+#include <catch2/catch_test_macros.hpp>
+#include "big_num/internal/integer_parse.hpp"
+#include "test_helpers.hpp"
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace big_num::internal;
+using namespace big_num::test;
+
+namespace {
+	// The digits with `sep` in front of every `group` of them counted from the end.
+	auto grouped(std::string const& digits, std::size_t group, std::string const& sep) -> std::string {
+		auto res = std::string{};
+		for (auto i = 0zu; i < digits.size(); ++i) {
+			if (i != 0 && (digits.size() - i) % group == 0) res += sep;
+			res += digits[i];
+		}
+		return res;
+	}
+} // namespace
+
+TEST_CASE("Decimal conversion", "[parse:to_string]") {
+	constexpr auto naive_max = MachineConfig::to_string_naive_threshold;
+
+	SECTION("Known values") {
+		REQUIRE(to_string(Integer{}.to_span()) == "0");
+		REQUIRE(to_string(make("-0").to_span()) == "0");
+		REQUIRE(to_string(make("-2147483648").to_span()) == "-2147483648");
+		auto const x = make("0x" + std::string(50, 'f'));
+		REQUIRE(to_string(x.to_span()) == "1606938044258990275541962092341162602522202993782792835301375");
+	}
+
+	SECTION("Against dividing out digits") {
+		auto g = std::mt19937_64(41);
+		// the basecase, one split, and several levels of splits
+		for (auto n : { 1zu, 2zu, naive_max - 1, naive_max, naive_max + 1, 2 * naive_max + 1, 100zu, 257zu, 700zu }) {
+			for (auto ones : { false, true }) {
+				auto const x = random_integer(g, n, g() & 1, ones);
+				auto const expected = (x.is_neg() ? "-" : "") + naive_digits(x);
+				REQUIRE(to_string(x.to_span()) == expected);
+				REQUIRE(hex(make(expected)) == hex(x));
+			}
+		}
+	}
+
+	SECTION("Next to powers of ten") {
+		// the digit count is only settled by comparing against the power here,
+		// and the splits leave runs of zeros or nines in every part
+		for (auto k : { 1zu, 9zu, 18zu, 19zu, 280zu, 300zu, 1000zu, 4321zu }) {
+			auto const power = "1" + std::string(k, '0');
+			auto const nines = std::string(k, '9');
+			auto const next = "1" + std::string(k - 1, '0') + "1";
+			for (auto const& text : { power, nines, next }) {
+				auto const x = make(text);
+				REQUIRE(naive_digits(x) == text);
+				REQUIRE(to_string(x.to_span()) == text);
+				REQUIRE(to_string(make("-" + text).to_span()) == "-" + text);
+			}
+		}
+	}
+
+	SECTION("Separators across the splits") {
+		auto g = std::mt19937_64(411);
+		for (auto n : { 3zu, naive_max + 3, 150zu }) {
+			auto const x = random_integer(g, n, true);
+			auto const digits = naive_digits(x);
+			REQUIRE(to_string(x.to_span(), 10, { .show_separator = true }) == "-" + grouped(digits, 3, "_"));
+			REQUIRE(to_string(x.to_span(), 10, { .show_separator = true, .separator = ", ", .group_size = 7 }) == "-" + grouped(digits, 7, ", "));
+			// the prefix only exists for the power-of-two radixes
+			REQUIRE(to_string(x.to_span(), 10, { .show_prefix = true }) == "-" + digits);
+		}
+	}
+}
+
+TEST_CASE("Printing without a string", "[parse:to_chars]") {
+	auto g = std::mt19937_64(46);
+	auto values = std::vector<Integer>{ Integer{}, make("-1"), make("1000000000") };
+	for (auto n : { 1zu, 5zu, MachineConfig::to_string_naive_threshold + 1, 100zu }) {
+		values.push_back(random_integer(g, n, g() & 1));
+	}
+	auto const configs = {
+		IntegerStringConvConfig{},
+		IntegerStringConvConfig{ .show_prefix = true },
+		IntegerStringConvConfig{ .show_prefix = true, .show_separator = true },
+		IntegerStringConvConfig{ .show_separator = true, .separator = ", ", .group_size = 5 },
+	};
+
+	for (auto const& x : values) {
+		for (std::uint8_t radix : { 2, 8, 10, 16 }) {
+			for (auto const& config : configs) {
+				auto const expected = to_string(x.to_span(), radix, config);
+				auto const n = chars_length(x.to_span(), radix, config);
+				REQUIRE(n == expected.size());
+
+				// exactly large enough
+				auto buf = std::string(n, '#');
+				auto const r = to_chars(buf.data(), buf.data() + n, x.to_span(), radix, config);
+				REQUIRE(r.ec == std::errc{});
+				REQUIRE(r.ptr == buf.data() + n);
+				REQUIRE(buf == expected);
+
+				// one short, and the range is left alone
+				auto small = std::string(n - 1, '#');
+				auto const f = to_chars(small.data(), small.data() + small.size(), x.to_span(), radix, config);
+				REQUIRE(f.ec == std::errc::value_too_large);
+				REQUIRE(f.ptr == small.data() + small.size());
+				REQUIRE(small == std::string(n - 1, '#'));
+
+				// a sink passed by reference
+				auto pieces = std::string{};
+				auto sink = [&pieces](std::string_view s) { pieces += s; };
+				write_integer(sink, x.to_span(), radix, config);
+				REQUIRE(pieces == expected);
+
+				auto it = std::string{};
+				to_chars(std::back_inserter(it), x.to_span(), radix, config);
+				REQUIRE(it == expected);
+			}
+		}
+	}
+}